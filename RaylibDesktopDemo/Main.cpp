@@ -1,32 +1,404 @@
-#include <__msvc_ostream.hpp>
+#include <algorithm>
 #include <iostream>
-
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
 
 #include "RaylibDesktop.h"
+#include "RaylibDesktopAssets.h"
+#include "RaylibDesktopAudio.h"
+#include "RaylibDesktopHeadless.h"
+#include "RaylibDesktopHost.h"
 #include "raylib.h"
 
-int main()
+// Command line options
+//   --headless              Render offscreen without attaching to the desktop and print a frame time report
+//   --frames <count>        Number of frames to render in headless mode (default 600)
+//   --size <width>x<height> Resolution of the scripted desktop in headless mode (default 1920x1080),
+//                           ignored when the timeline declares monitors
+//   --timeline <file>       Scripted input and occlusion timeline for headless mode, see RaylibDesktopHeadless.h
+//   --report <file>         Also write the headless report to a file
+//   --slideshow <directory> Show the images in a directory as the background, changing every 300 frames
+//   --wave <file>           Visualise a WAV file instead of the audio played by the system
+//   --host                  Run an independent scene on every monitor in one process, see RaylibDesktopHost.h
+struct DemoOptions
+{
+	bool headless = false;
+	int frames = 600;
+	int width = 1920;
+	int height = 1080;
+	bool sizeGiven = false; // --size was passed, the timeline's monitors may override it
+	const char *timeline = NULL;
+	const char *report = NULL;
+	const char *slideshow = NULL;
+	const char *wave = NULL;
+	bool host = false;
+};
+
+static bool ParseOptions(int argc, char **argv, DemoOptions &options)
+{
+	for (int i = 1; i < argc; i++) {
+		const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+
+		if (strcmp(argv[i], "--headless") == 0) {
+			options.headless = true;
+			continue;
+		}
+		if (strcmp(argv[i], "--host") == 0) {
+			options.host = true;
+			continue;
+		}
+		if (!value) {
+			std::cerr << "Unknown option or missing value: " << argv[i] << std::endl;
+			return false;
+		}
+
+		if (strcmp(argv[i], "--frames") == 0) {
+			options.frames = atoi(value);
+		}
+		else if (strcmp(argv[i], "--size") == 0) {
+			if (sscanf(value, "%dx%d", &options.width, &options.height) != 2)
+				return false;
+			options.sizeGiven = true;
+		}
+		else if (strcmp(argv[i], "--timeline") == 0) {
+			options.timeline = value;
+		}
+		else if (strcmp(argv[i], "--report") == 0) {
+			options.report = value;
+		}
+		else if (strcmp(argv[i], "--slideshow") == 0) {
+			options.slideshow = value;
+		}
+		else if (strcmp(argv[i], "--wave") == 0) {
+			options.wave = value;
+		}
+		else {
+			std::cerr << "Unknown option: " << argv[i] << std::endl;
+			return false;
+		}
+		i++;
+	}
+
+	return options.frames > 0 && options.width > 0 && options.height > 0;
+}
+
+// Headless mode renders each frame into an offscreen target instead of the window.
+static void BeginFrame(const RenderTexture2D &headlessTarget)
+{
+	BeginDrawing();
+	if (headlessTarget.id != 0)
+		BeginTextureMode(headlessTarget);
+}
+
+static void EndFrame(const RenderTexture2D &headlessTarget)
+{
+	if (headlessTarget.id != 0)
+		EndTextureMode();
+	EndDrawing();
+}
+
+// Returns the given percentile (0 - 100) of sorted values
+static double Percentile(const std::vector<double> &sortedValues, double percentile)
+{
+	if (sortedValues.empty())
+		return 0.0;
+	size_t index = static_cast<size_t>(percentile / 100.0 * (sortedValues.size() - 1) + 0.5);
+	return sortedValues[index];
+}
+
+// Prints the frame time percentiles, CPU time and peak memory of a headless run
+static void WriteHeadlessReport(
+	FILE *file,
+	const MonitorInfo &monitorInfo,
+	std::vector<double> frameTimes,
+	int skippedFrames,
+	double totalSeconds
+)
+{
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	double cpuSeconds = 0.0;
+	size_t peakMemoryBytes = 0;
+	RaylibDesktopGetProcessStats(&cpuSeconds, &peakMemoryBytes);
+
+	fprintf(file, "resolution: %dx%d\n", monitorInfo.monitorWidth, monitorInfo.monitorHeight);
+	fprintf(file, "frames: %d rendered, %d skipped\n", (int)frameTimes.size(), skippedFrames);
+	fprintf(
+		file,
+		"frame time ms: p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n",
+		Percentile(frameTimes, 50.0) * 1000.0,
+		Percentile(frameTimes, 90.0) * 1000.0,
+		Percentile(frameTimes, 99.0) * 1000.0,
+		(frameTimes.empty() ? 0.0 : frameTimes.back()) * 1000.0
+	);
+	fprintf(file, "wall time s: %.3f\n", totalSeconds);
+	fprintf(file, "cpu time s: %.3f\n", cpuSeconds);
+	fprintf(file, "peak memory MB: %.1f\n", peakMemoryBytes / (1024.0 * 1024.0));
+
+	// Scheduling of every scene when running as a multi-wallpaper host
+	for (int i = 0; i < RaylibDesktopHostGetSceneCount(); i++) {
+		RaylibDesktopSceneStats stats;
+		RaylibDesktopHostGetSceneStats(i, &stats);
+		fprintf(
+			file,
+			"scene %d: %d updates, %d culled frames, tier %d\n",
+			i,
+			stats.updates,
+			stats.culledFrames,
+			stats.currentTier
+		);
+	}
+}
+
+// Prints the report of a headless run, and writes it to the --report file
+static void PrintHeadlessReports(
+	const DemoOptions &options,
+	const MonitorInfo &monitorInfo,
+	const std::vector<double> &frameTimes,
+	int skippedFrames,
+	double totalSeconds
+)
+{
+	WriteHeadlessReport(stdout, monitorInfo, frameTimes, skippedFrames, totalSeconds);
+
+	if (options.report) {
+		FILE *reportFile = fopen(options.report, "w");
+		if (reportFile) {
+			WriteHeadlessReport(reportFile, monitorInfo, frameTimes, skippedFrames, totalSeconds);
+			fclose(reportFile);
+		}
+	}
+}
+
+// Multi-wallpaper host scene: a bouncing circle per monitor
+struct BouncingScene
+{
+	float circleX;
+	float circleY;
+	float circleRadius;
+	float speedX; // Pixels per second
+	float speedY;
+	Color color;
+};
+
+// Runs on the host's update pool, only touches its own scene
+static void UpdateBouncingScene(void *userData, const RaylibDesktopSceneContext *context)
+{
+	BouncingScene *scene = static_cast<BouncingScene *>(userData);
+	scene->circleX += scene->speedX * context->deltaTime;
+	scene->circleY += scene->speedY * context->deltaTime;
+
+	// Bounce off the monitor's edges.
+	float width = (float)context->monitor.monitorWidth;
+	float height = (float)context->monitor.monitorHeight;
+	if (scene->circleX - scene->circleRadius < 0 || scene->circleX + scene->circleRadius > width)
+		scene->speedX = -scene->speedX;
+	if (scene->circleY - scene->circleRadius < 0 || scene->circleY + scene->circleRadius > height)
+		scene->speedY = -scene->speedY;
+}
+
+static void DrawBouncingScene(void *userData, const RaylibDesktopSceneContext *context)
+{
+	const BouncingScene *scene = static_cast<const BouncingScene *>(userData);
+	ClearBackground(RAYWHITE);
+	DrawCircle((int)scene->circleX, (int)scene->circleY, scene->circleRadius, scene->color);
+
+	if (context->mouseInside && RaylibDesktopIsMouseButtonDown(0) &&
+		(context->tier.effectFlags & RAYLIB_DESKTOP_EFFECT_MOUSE_INTERACTION)) {
+		DrawCircle(context->mouseX, context->mouseY, 10, BLUE);
+	}
+
+	DrawText(
+		TextFormat("Monitor %d: %s", context->sceneIndex, context->tier.name ? context->tier.name : "unnamed"),
+		10,
+		40,
+		30,
+		DARKGRAY
+	);
+}
+
+// Runs one scene per monitor inside the spanning wallpaper window.
+// Headless runs use a simulated 60 FPS clock, so the scene scheduling only depends on the timeline.
+static void
+RunWallpaperHost(const DemoOptions &options, const MonitorInfo &monitorInfo, const RenderTexture2D &headlessTarget)
+{
+	static const Color sceneColors[] = {RED, ORANGE, GREEN, PURPLE, SKYBLUE, GOLD, PINK, LIME};
+
+	std::vector<MonitorInfo> monitors = EnumerateAllMonitors();
+	if (monitors.empty())
+		monitors.push_back(monitorInfo);
+
+	InitRaylibDesktopHost(monitorInfo, NULL);
+
+	std::vector<BouncingScene> scenes(monitors.size());
+	for (size_t i = 0; i < monitors.size(); i++) {
+		BouncingScene &scene = scenes[i];
+		scene.circleX = monitors[i].monitorWidth / 2.0f;
+		scene.circleY = monitors[i].monitorHeight / 2.0f;
+		scene.circleRadius = 100.0f;
+		scene.speedX = 240.0f + 30.0f * i;
+		scene.speedY = 270.0f - 30.0f * i;
+		scene.color = sceneColors[i % (sizeof(sceneColors) / sizeof(sceneColors[0]))];
+
+		RaylibDesktopScene callbacks = {&scene, UpdateBouncingScene, DrawBouncingScene, NULL};
+		RaylibDesktopHostAddScene(monitors[i], callbacks);
+	}
+
+	int frame = 0;
+	int skippedFrames = 0;
+	int targetFps = 0;
+	std::vector<double> frameTimes;
+	frameTimes.reserve(options.frames);
+	double runStart = GetTime();
+
+	while (options.headless ? frame < options.frames : !WindowShouldClose()) {
+		double frameStart = GetTime();
+		frame++;
+
+		// Shared services are sampled once per frame and fanned out to the scenes by the host.
+		RaylibDesktopUpdateMouseState();
+		if (RaylibDesktopIsMouseButtonPressed(1)) {
+			// exit on right click
+			break;
+		}
+
+		RaylibDesktopHostUpdate(options.headless ? frame / 60.0 : GetTime());
+
+		// Every monitor is occluded, the desktop is locked or every scene is paused by its tier
+		if (RaylibDesktopHostGetTargetFps() == 0) {
+			skippedFrames++;
+			if (!options.headless)
+				WaitTime(0.1);
+			continue;
+		}
+
+		// The window runs at the rate of the fastest visible scene, slower scenes are updated less often.
+		if (!options.headless && RaylibDesktopHostGetTargetFps() != targetFps) {
+			targetFps = RaylibDesktopHostGetTargetFps();
+			SetTargetFPS(targetFps);
+		}
+
+		RaylibDesktopHostRender();
+
+		BeginFrame(headlessTarget);
+		ClearBackground(BLACK);
+		RaylibDesktopHostDraw();
+		DrawFPS(10, 10);
+		EndFrame(headlessTarget);
+
+		frameTimes.push_back(GetTime() - frameStart);
+	}
+
+	if (options.headless)
+		PrintHeadlessReports(options, monitorInfo, frameTimes, skippedFrames, GetTime() - runStart);
+
+	CleanupRaylibDesktopHost();
+}
+
+int main(int argc, char **argv)
 {
-	// Initializes desktop replacement magic
-	InitRaylibDesktop();
+	DemoOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		std::cerr << "Usage: RaylibDesktopDemo [--headless] [--frames <count>] [--size <width>x<height>] "
+					 "[--timeline <file>] [--report <file>] [--slideshow <directory>] [--wave <file>] [--host]"
+				  << std::endl;
+		return 1;
+	}
 
-	// Sets up the desktop (-1 is the entire desktop spanning all monitors)
-	MonitorInfo monitorInfo = GetWallpaperTarget(-1);
+	MonitorInfo monitorInfo;
+	RenderTexture2D headlessTarget = {0};
 
-	// Initialize the raylib window.
-	InitWindow(monitorInfo.monitorWidth, monitorInfo.monitorHeight, "Raylib Desktop Demo");
+	if (options.headless) {
+		// Replaces the desktop with the scripted timeline, nothing is attached to the real desktop.
+		if (InitRaylibDesktopHeadless(options.width, options.height, options.timeline) != 0) {
+			std::cerr << "Failed to load timeline" << std::endl;
+			return 1;
+		}
 
-	// Retrieve the handle for the raylib-created window.
-	void *raylibWindowHandle = GetWindowHandle();
+		// The scripted desktop, --size unless the timeline declares monitors
+		monitorInfo = GetWallpaperTarget(-1);
+		if (options.sizeGiven &&
+			(monitorInfo.monitorWidth != options.width || monitorInfo.monitorHeight != options.height)) {
+			std::cerr << "Warning: the monitors of " << options.timeline << " override --size " << options.width << "x"
+					  << options.height << ", rendering " << monitorInfo.monitorWidth << "x"
+					  << monitorInfo.monitorHeight << std::endl;
+		}
+
+		// The window is only needed for the GL context, the frames go to an offscreen target.
+		SetConfigFlags(FLAG_WINDOW_HIDDEN);
+		InitWindow(320, 240, "Raylib Desktop Demo (headless)");
+		headlessTarget = LoadRenderTexture(monitorInfo.monitorWidth, monitorInfo.monitorHeight);
+	}
+	else {
+		// Initializes desktop replacement magic, other platforms only support --headless
+		if (InitRaylibDesktop() != 0)
+			return 1;
 
-	// Reparent the raylib window to the window behind the desktop icons.
-	RaylibDesktopReparentWindow(raylibWindowHandle);
+		// Sets up the desktop (-1 is the entire desktop spanning all monitors)
+		monitorInfo = GetWallpaperTarget(-1);
+
+		// Initialize the raylib window.
+		InitWindow(monitorInfo.monitorWidth, monitorInfo.monitorHeight, "Raylib Desktop Demo");
+
+		// Retrieve the handle for the raylib-created window.
+		void *raylibWindowHandle = GetWindowHandle();
+
+		// Reparent the raylib window to the window behind the desktop icons.
+		RaylibDesktopReparentWindow(raylibWindowHandle);
+	}
 
 	// Configure the desktop positioning.
 	ConfigureDesktopPositioning(monitorInfo);
 
 	// Now, enter the raylib render loop.
-	SetTargetFPS(60);
+	// Headless runs are not throttled, so the report shows the actual cost of a frame.
+	SetTargetFPS(options.headless ? 0 : 60);
+
+	if (options.host) {
+		RunWallpaperHost(options, monitorInfo, headlessTarget);
+
+		if (headlessTarget.id != 0)
+			UnloadRenderTexture(headlessTarget);
+		CloseWindow();
+		CleanupRaylibDesktop();
+		return 0;
+	}
+
+	// Quality policy: lowers FPS, resolution and effects on battery, in fullscreen apps or when idle.
+	RaylibDesktopQualityPolicy qualityPolicy = RaylibDesktopDefaultQualityPolicy();
+	RaylibDesktopPolicyState qualityState = {-1, -1, 0.0};
+	RaylibDesktopQualityTier qualityTier = RaylibDesktopGetQualityTier(qualityPolicy, qualityState);
+	double nextPolicyUpdate = 0.0;
+
+	// Offscreen target used when the tier renders below native resolution
+	RenderTexture2D scaledTarget = {0};
+
+	// Audio visualiser: analyses whatever the default output device is playing.
+	bool audioEnabled = false;
+	if (options.wave)
+		audioEnabled = InitRaylibDesktopAudioFromWave(options.wave, NULL) == 0;
+	else if (!options.headless)
+		audioEnabled = InitRaylibDesktopAudioLoopback(NULL) == 0;
+	RaylibDesktopAudioSpectrum spectrum = {0};
+
+	// Slideshow: images are decoded in the background and uploaded within a per-frame budget.
+	FilePathList slideFiles = {0};
+	std::vector<const char *> slides;
+	int currentSlide = 0;
+	if (options.slideshow) {
+		slideFiles = LoadDirectoryFiles(options.slideshow);
+		for (unsigned int i = 0; i < slideFiles.count; i++) {
+			if (IsFileExtension(slideFiles.paths[i], ".png;.jpg;.jpeg;.bmp;.qoi")) {
+				slides.push_back(slideFiles.paths[i]);
+			}
+		}
+
+		InitRaylibDesktopAssetLoader(NULL);
+		if (!slides.empty())
+			RaylibDesktopPrefetchSlides(slides.data(), (int)slides.size(), currentSlide, 2);
+	}
 
 	// --- Animation variables ---
 	float circleX = monitorInfo.monitorWidth / 2.0f;
@@ -35,26 +407,94 @@ int main()
 	float speedX = 4.0f;
 	float speedY = 4.5f;
 
+	// Headless frame statistics
+	int frame = 0;
+	int skippedFrames = 0;
+	std::vector<double> frameTimes;
+	frameTimes.reserve(options.frames);
+	double runStart = GetTime();
+
 	// Main render loop.
-	while (!WindowShouldClose()) {
+	while (options.headless ? frame < options.frames : !WindowShouldClose()) {
+		double frameStart = GetTime();
+		frame++;
+
+		// Headless runs follow the timeline's simulated 60 FPS clock, so their tier changes are reproducible.
+		double now = options.headless ? frame / 60.0 : GetTime();
+
 		// Update the mouse state of the replacement api.
 		RaylibDesktopUpdateMouseState();
 
 		// skip rendering if the wallpaper is occluded more than 95%
 		if (IsMonitorOccluded(monitorInfo, 0.95)) {
-			std::cout << "Wallpaper is occluded" << std::endl;
-			WaitTime(0.1);
+			RaylibDesktopSetAudioAnalysisPaused(true);
+			skippedFrames++;
+			if (!options.headless) {
+				std::cout << "Wallpaper is occluded" << std::endl;
+				WaitTime(0.1);
+			}
 			continue;
 		}
 
-		if (IsDesktopLocked() ) {
-			std::cout << "Desktop is locked" << std::endl;
+		if (IsDesktopLocked()) {
 			// If the desktop is locked, we can skip rendering.
 			// This is useful to avoid unnecessary rendering when the user is not interacting with the desktop.
-			WaitTime(0.1);
+			RaylibDesktopSetAudioAnalysisPaused(true);
+			skippedFrames++;
+			if (!options.headless) {
+				std::cout << "Desktop is locked" << std::endl;
+				WaitTime(0.1);
+			}
 			continue;
 		}
 
+		RaylibDesktopSetAudioAnalysisPaused(false);
+
+		// Re-evaluate the quality tier once per second, the inputs are too expensive to query every frame.
+		if (now >= nextPolicyUpdate) {
+			nextPolicyUpdate = now + 1.0;
+
+			RaylibDesktopPolicyInputs policyInputs;
+			RaylibDesktopQueryPolicyInputs(monitorInfo, &policyInputs);
+
+			if (RaylibDesktopUpdateQualityTier(qualityPolicy, qualityState, policyInputs, now)) {
+				qualityTier = RaylibDesktopGetQualityTier(qualityPolicy, qualityState);
+				std::cout << "Quality tier: " << (qualityTier.name ? qualityTier.name : "unnamed") << std::endl;
+
+				if (!options.headless)
+					SetTargetFPS(qualityTier.targetFps);
+
+				if (scaledTarget.id != 0) {
+					UnloadRenderTexture(scaledTarget);
+					scaledTarget = {0};
+				}
+				if (qualityTier.resolutionScale < 1.0f) {
+					scaledTarget = LoadRenderTexture(
+						(int)(monitorInfo.monitorWidth * qualityTier.resolutionScale),
+						(int)(monitorInfo.monitorHeight * qualityTier.resolutionScale)
+					);
+				}
+			}
+		}
+
+		if (qualityTier.targetFps <= 0) {
+			skippedFrames++;
+			if (!options.headless)
+				WaitTime(0.1);
+			continue;
+		}
+
+		// Advance the slideshow and upload decoded images within a 4 ms budget.
+		Texture2D slideTexture = {0};
+		if (!slides.empty()) {
+			if (frame % 300 == 0) {
+				currentSlide = (currentSlide + 1) % (int)slides.size();
+				RaylibDesktopPrefetchSlides(slides.data(), (int)slides.size(), currentSlide, 2);
+			}
+			RaylibDesktopUploadImages(0.004);
+			RaylibDesktopGetImageTexture(slides[currentSlide], &slideTexture);
+		}
+
 		// Update the circle's position.
 		circleX += speedX;
 		circleY += speedY;
@@ -67,19 +507,48 @@ int main()
 			speedY = -speedY;
 
 		// Begin the drawing phase.
-		BeginDrawing();
+		// Reduced resolution tiers draw into the smaller offscreen target, scaled with a camera.
+		Camera2D camera = {0};
+		camera.zoom = 1.0f;
+		if (scaledTarget.id != 0) {
+			camera.zoom = qualityTier.resolutionScale;
+			BeginTextureMode(scaledTarget);
+		}
+		else {
+			BeginFrame(headlessTarget);
+		}
+		BeginMode2D(camera);
 		ClearBackground(RAYWHITE);
 
+		// Draw the current slide stretched over the wallpaper, once it is uploaded.
+		if (slideTexture.id != 0) {
+			Rectangle source = {0, 0, (float)slideTexture.width, (float)slideTexture.height};
+			Rectangle dest = {0, 0, (float)monitorInfo.monitorWidth, (float)monitorInfo.monitorHeight};
+			DrawTexturePro(slideTexture, source, dest, {0, 0}, 0.0f, WHITE);
+		}
+
 		// Draw a bouncing red circle.
 		DrawCircle((int)circleX, (int)circleY, circleRadius, RED);
 
+		// Draw the audio spectrum along the bottom edge.
+		if (audioEnabled) {
+			RaylibDesktopGetAudioSpectrum(&spectrum);
+			float barWidth = (float)monitorInfo.monitorWidth / (spectrum.bandCount > 0 ? spectrum.bandCount : 1);
+			for (int i = 0; i < spectrum.bandCount; i++) {
+				float barHeight = spectrum.bands[i] * monitorInfo.monitorHeight * 0.25f;
+				DrawRectangleRec(
+					{i * barWidth, monitorInfo.monitorHeight - barHeight, barWidth - 2.0f, barHeight}, Fade(MAROON, 0.6f)
+				);
+			}
+		}
+
 		// Attempt to display the mouse position.
 		// Note: In a wallpaper window (child of WorkerW), input may not be delivered normally.
 		int mouseX = RaylibDesktopGetMouseX();
 		int mouseY = RaylibDesktopGetMouseY();
 
 		// check buttons
-		if (RaylibDesktopIsMouseButtonDown(0)) {
+		if (RaylibDesktopIsMouseButtonDown(0) && (qualityTier.effectFlags & RAYLIB_DESKTOP_EFFECT_MOUSE_INTERACTION)) {
 			DrawCircle(mouseX, mouseY, 10, BLUE);
 		}
 		else if (RaylibDesktopIsMouseButtonPressed(1)) {
@@ -88,11 +557,41 @@ int main()
 		}
 
 		DrawText(TextFormat("Mouse: %d, %d", mouseX, mouseY), mouseX, mouseY, 30, DARKGRAY);
+		EndMode2D();
+
+		if (scaledTarget.id != 0) {
+			EndTextureMode();
+
+			// Upscale the offscreen target to the wallpaper, render textures are flipped vertically
+			BeginFrame(headlessTarget);
+			Rectangle source = {0, 0, (float)scaledTarget.texture.width, -(float)scaledTarget.texture.height};
+			Rectangle dest = {0, 0, (float)monitorInfo.monitorWidth, (float)monitorInfo.monitorHeight};
+			DrawTexturePro(scaledTarget.texture, source, dest, {0, 0}, 0.0f, WHITE);
+		}
 
 		DrawFPS(10, 10);
-		EndDrawing();
+		EndFrame(headlessTarget);
+
+		frameTimes.push_back(GetTime() - frameStart);
+	}
+
+	if (options.headless)
+		PrintHeadlessReports(options, monitorInfo, frameTimes, skippedFrames, GetTime() - runStart);
+
+	if (options.slideshow) {
+		CleanupRaylibDesktopAssetLoader();
+		UnloadDirectoryFiles(slideFiles);
 	}
 
+	if (scaledTarget.id != 0)
+		UnloadRenderTexture(scaledTarget);
+
+	if (headlessTarget.id != 0)
+		UnloadRenderTexture(headlessTarget);
+
+	if (audioEnabled)
+		CleanupRaylibDesktopAudio();
+
 	// Close the window and unload resources.
 	CloseWindow();
 
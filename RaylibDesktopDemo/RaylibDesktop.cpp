@@ -1,5 +1,12 @@
 #include "RaylibDesktop.h"
+#include "RaylibDesktopHeadless.h"
+#include "RaylibDesktopOcclusion.h"
 
+#include <stdio.h>
+
+// Windows desktop implementation and headless mode, whose scripted state lives in RaylibDesktopHeadless.cpp.
+// Other platforms only support headless mode, the desktop parts are compiled on Windows only.
+#ifdef _WIN32
 #include <Windows.h>
 #include <limits>
 #include <memory>
@@ -12,11 +19,46 @@
 #include <shlwapi.h>
 #pragma comment(lib, "Shlwapi.lib")
 
+// For SHQueryUserNotificationState
+#include <shellapi.h>
+#pragma comment(lib, "Shell32.lib")
+
 // For DPI awareness functions
 #include <shellscalingapi.h>
 // Required for SetProcessDpiAwareness and GetDpiForMonitor
 #pragma comment(lib, "Shcore.lib")
 
+// For GetProcessMemoryInfo
+#include <psapi.h>
+#pragma comment(lib, "Psapi.lib")
+#else
+// For getrusage
+#include <sys/resource.h>
+#endif
+
+// Fixed capacity buffers reused every frame, so the per-frame functions never allocate.
+// Maximum number of monitors tracked by EnumerateAllMonitors
+#define MAX_MONITORS RAYLIB_DESKTOP_MAX_MONITORS
+// Maximum number of occluding windows tracked by IsMonitorOccluded
+#define MAX_OCCLUDED_RECTS RAYLIB_DESKTOP_MAX_OCCLUDING_WINDOWS
+
+// monitors found by the last enumeration, in desktop coordinates
+MonitorInfo g_monitors[MAX_MONITORS];
+int g_monitorCount = 0;
+
+// the offset to the desktop coordinates
+// windows desktop coordinates start at the top left of the primary monitor
+// subtract this offset to get the desktop coordinates
+int g_desktopX = 0;
+int g_desktopY = 0;
+
+// Reused by every occlusion query instead of allocating per frame
+static FullscreenOcclusionData g_occlusionData;
+
+// current monitor in desktop coordinates
+MonitorInfo g_selectedMonitor = {0, 0, 0, 0};
+
+#ifdef _WIN32
 // Global variables to hold handles within the desktop hierarchy
 // g_progmanWindowHandle : top level Program Manager window
 // g_workerWindowHandle  : child WorkerW window rendering the static wallpaper
@@ -27,26 +69,19 @@ HWND g_workerWindowHandle = NULL;
 HWND g_shellViewWindowHandle = NULL;
 HWND g_raylibWindowHandle = NULL;
 
-// current monitor in desktop coordinates
-MonitorInfo g_selectedMonitor = {0, 0, 0, 0};
-
-// the offset to the desktop coordinates
-// windows desktop coordinates start at the top left of the primary monitor
-// subtract this offset to get the desktop coordinates
-int g_desktopX = 0;
-int g_desktopY = 0;
-
 // Monitor enumeration
 // Callback function called for each monitor by EnumDisplayMonitors
 BOOL CALLBACK MonitorEnumProc(
 	HMONITOR monitorHandle, // Handle to the display monitor
 	HDC monitorDeviceContext, // Handle to a device context (not used here)
 	LPRECT monitorRectangle, // Pointer to a RECT structure (not used directly)
-	LPARAM lParam // Application-defined data; here, a pointer to a vector<MonitorInfo>
+	LPARAM lParam // Application-defined data (not used here)
 )
 {
-	// Cast lParam to a pointer to our vector of MonitorInfo
-	std::vector<MonitorInfo> *pointerToMonitorVector = reinterpret_cast<std::vector<MonitorInfo> *>(lParam);
+	// Stop the enumeration once the monitor buffer is full
+	if (g_monitorCount >= MAX_MONITORS) {
+		return FALSE;
+	}
 
 	// Prepare a MONITORINFOEX structure to receive monitor information
 	MONITORINFOEX monitorInfoEx;
@@ -67,73 +102,14 @@ BOOL CALLBACK MonitorEnumProc(
 		currentMonitorInfo.monitorWidth = widthOfMonitor;
 		currentMonitorInfo.monitorHeight = heightOfMonitor;
 
-		// Add the monitor information to the vector
-		pointerToMonitorVector->push_back(currentMonitorInfo);
+		// Add the monitor information to the buffer
+		g_monitors[g_monitorCount++] = currentMonitorInfo;
 	}
 
 	// Returning TRUE tells EnumDisplayMonitors to continue the enumeration.
 	return TRUE;
 }
 
-// Function to enumerate all monitors and return their information
-std::vector<MonitorInfo> EnumerateAllMonitors()
-{
-	// Vector to store information about each monitor
-	std::vector<MonitorInfo> monitorInfoVector;
-
-	// Call EnumDisplayMonitors.
-	// The first two parameters are NULL to indicate the entire virtual screen.
-	// The callback MonitorEnumProc will be called for each monitor.
-	EnumDisplayMonitors(NULL, NULL, MonitorEnumProc, reinterpret_cast<LPARAM>(&monitorInfoVector));
-
-	// convert to desktop coordinates which start at 0,0
-	g_desktopX = INT_MAX;
-	g_desktopY = INT_MAX;
-
-	for (auto &monitor : monitorInfoVector) {
-		if (monitor.monitorLeftCoordinate < g_desktopX) {
-			g_desktopX = monitor.monitorLeftCoordinate;
-		}
-		if (monitor.monitorTopCoordinate < g_desktopY) {
-			g_desktopY = monitor.monitorTopCoordinate;
-		}
-	}
-
-	for (auto &monitor : monitorInfoVector) {
-		monitor.monitorLeftCoordinate -= g_desktopX;
-		monitor.monitorTopCoordinate -= g_desktopY;
-	}
-
-	return monitorInfoVector;
-}
-
-MonitorInfo GetWallpaperTarget(int monitorIndex)
-{
-	// If monitorIndex is -1, then we use the entire virtual desktop.
-	std::vector<MonitorInfo> monitors = EnumerateAllMonitors();
-
-	if (monitorIndex < 0 || monitorIndex >= static_cast<int>(monitors.size())) {
-		MonitorInfo info;
-		info.monitorLeftCoordinate = 0; // GetSystemMetrics(SM_XVIRTUALSCREEN);
-		info.monitorTopCoordinate = 0; // GetSystemMetrics(SM_YVIRTUALSCREEN);
-		info.monitorWidth = GetSystemMetrics(SM_CXVIRTUALSCREEN);
-		info.monitorHeight = GetSystemMetrics(SM_CYVIRTUALSCREEN);
-		return info;
-	}
-	else {
-		// Otherwise, try to get the desired monitor from the enumeration.
-		return monitors[monitorIndex];
-	}
-}
-
-// Wallpaper Occlusion Fix
-// Data structure to hold parameters for occlusion detection via EnumWindows.
-struct FullscreenOcclusionData
-{
-	MonitorInfo monitor; // Target monitor area (already adjusted relative to (0,0))
-	std::vector<RECT> occludedRects; // Rectangles of occluded areas
-};
-
 static bool IsInvisibleWin10BackgroundAppWindow(HWND hWnd)
 {
 	int CloakedVal;
@@ -144,43 +120,6 @@ static bool IsInvisibleWin10BackgroundAppWindow(HWND hWnd)
 	return CloakedVal ? true : false;
 }
 
-// @brief Computes the fraction of the monitor area that is occluded by any rectangle in occludedRects.
-// @param occludedRects A vector of RECTs representing occluded regions.
-// @param monitor The monitor info (with coordinates relative to your desktop, starting at (0,0)).
-// @param sampleStep The spacing (in pixels) between sample points on the grid.
-// @return A value between 0.0 and 1.0 representing the approximate fraction of the monitor area that is occluded.
-double
-ComputeOcclusionFraction(const std::vector<RECT> &occludedRects, const MonitorInfo &monitor, int sampleStep = 100)
-{
-	int occludedCount = 0;
-	int totalSamples = 0;
-
-	// Loop over the monitor's area using the given step size.
-	for (int y = monitor.monitorTopCoordinate; y < monitor.monitorTopCoordinate + monitor.monitorHeight;
-		 y += sampleStep) {
-		for (int x = monitor.monitorLeftCoordinate; x < monitor.monitorLeftCoordinate + monitor.monitorWidth;
-			 x += sampleStep) {
-			totalSamples++;
-			bool isOccluded = false;
-			// Check if this sample point is within any occlusion rectangle.
-			for (const RECT &rect : occludedRects) {
-				if (x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom) {
-					isOccluded = true;
-					break;
-				}
-			}
-			if (isOccluded)
-				occludedCount++;
-		}
-	}
-
-	// Avoid division by zero.
-	if (totalSamples == 0)
-		return 0.0;
-
-	return static_cast<double>(occludedCount) / static_cast<double>(totalSamples);
-}
-
 // struct WindowDebug
 //{
 //	HWND hwnd;
@@ -235,28 +174,17 @@ BOOL CALLBACK FullscreenWindowEnumProc(HWND hwnd, LPARAM lParam)
 		return TRUE;
 
 	// convert window rect to desktop coordinates
-	windowRect.left -= g_desktopX;
-	windowRect.right -= g_desktopX;
-	windowRect.top -= g_desktopY;
-	windowRect.bottom -= g_desktopY;
-
-	// Build a rectangle for the target monitor.
-	RECT monitorRect;
-	monitorRect.left = occlusionData->monitor.monitorLeftCoordinate;
-	monitorRect.top = occlusionData->monitor.monitorTopCoordinate;
-	monitorRect.right = occlusionData->monitor.monitorLeftCoordinate + occlusionData->monitor.monitorWidth;
-	monitorRect.bottom = occlusionData->monitor.monitorTopCoordinate + occlusionData->monitor.monitorHeight;
-
-	// Calculate the intersection of the window's rectangle with the monitor's rectangle.
-	RECT intersectionRect;
-	if (!IntersectRect(&intersectionRect, &windowRect, &monitorRect)) {
-		// No intersection at all.
-		return TRUE;
+	OccludedRect occludedRect;
+	occludedRect.left = windowRect.left - g_desktopX;
+	occludedRect.top = windowRect.top - g_desktopY;
+	occludedRect.right = windowRect.right - g_desktopX;
+	occludedRect.bottom = windowRect.bottom - g_desktopY;
+
+	// store the part covering the target monitor, stop once the buffer is full
+	if (!AddOccludedRect(occlusionData, occludedRect)) {
+		return FALSE;
 	}
 
-	// store the occluded area
-	occlusionData->occludedRects.push_back(intersectionRect);
-
 	// double occludedFraction = ComputeOcclusionFraction(occlusionData->occludedRects, occlusionData->monitor);
 
 	// WindowDebug debugWindow;
@@ -277,6 +205,176 @@ BOOL CALLBACK FullscreenWindowEnumProc(HWND hwnd, LPARAM lParam)
 	return TRUE;
 }
 
+#endif
+
+// Monitors and occlusion, shared by the desktop and headless mode
+
+// Enumerates all monitors into g_monitors without allocating
+static void UpdateMonitors()
+{
+	g_monitorCount = 0;
+
+	// The scripted monitors already use desktop coordinates
+	if (RaylibDesktopIsHeadless()) {
+		g_monitorCount = RaylibDesktopHeadlessGetMonitors(g_monitors, MAX_MONITORS);
+		g_desktopX = 0;
+		g_desktopY = 0;
+		return;
+	}
+
+#ifdef _WIN32
+	// Call EnumDisplayMonitors.
+	// The first two parameters are NULL to indicate the entire virtual screen.
+	// The callback MonitorEnumProc will be called for each monitor.
+	EnumDisplayMonitors(NULL, NULL, MonitorEnumProc, 0);
+
+	// convert to desktop coordinates which start at 0,0
+	// The virtual screen origin is the top left of all monitors, including the ones past MAX_MONITORS
+	g_desktopX = GetSystemMetrics(SM_XVIRTUALSCREEN);
+	g_desktopY = GetSystemMetrics(SM_YVIRTUALSCREEN);
+
+	for (int i = 0; i < g_monitorCount; i++) {
+		g_monitors[i].monitorLeftCoordinate -= g_desktopX;
+		g_monitors[i].monitorTopCoordinate -= g_desktopY;
+	}
+#endif
+}
+
+// Function to enumerate all monitors and return their information
+std::vector<MonitorInfo> EnumerateAllMonitors()
+{
+	UpdateMonitors();
+	return std::vector<MonitorInfo>(g_monitors, g_monitors + g_monitorCount);
+}
+
+int RaylibDesktopGetMonitors(MonitorInfo *monitors, int capacity)
+{
+	UpdateMonitors();
+
+	int count = g_monitorCount < capacity ? g_monitorCount : capacity;
+	for (int i = 0; i < count; i++) {
+		monitors[i] = g_monitors[i];
+	}
+	return count;
+}
+
+MonitorInfo GetWallpaperTarget(int monitorIndex)
+{
+	// If monitorIndex is -1, then we use the entire virtual desktop.
+	UpdateMonitors();
+
+	if (monitorIndex < 0 || monitorIndex >= g_monitorCount) {
+		if (RaylibDesktopIsHeadless())
+			return RaylibDesktopHeadlessGetDesktop();
+
+		MonitorInfo info = {0, 0, 0, 0};
+#ifdef _WIN32
+		info.monitorLeftCoordinate = 0; // GetSystemMetrics(SM_XVIRTUALSCREEN);
+		info.monitorTopCoordinate = 0; // GetSystemMetrics(SM_YVIRTUALSCREEN);
+		info.monitorWidth = GetSystemMetrics(SM_CXVIRTUALSCREEN);
+		info.monitorHeight = GetSystemMetrics(SM_CYVIRTUALSCREEN);
+#endif
+		return info;
+	}
+	else {
+		// Otherwise, try to get the desired monitor from the enumeration.
+		return g_monitors[monitorIndex];
+	}
+}
+
+bool AddOccludedRect(FullscreenOcclusionData *occlusionData, const OccludedRect &windowRect)
+{
+	if (occlusionData->occludedRectCount >= MAX_OCCLUDED_RECTS)
+		return false;
+
+	// Calculate the intersection of the window's rectangle with the queried area.
+	const MonitorInfo &area = occlusionData->monitor;
+	OccludedRect intersectionRect = windowRect;
+	if (intersectionRect.left < area.monitorLeftCoordinate)
+		intersectionRect.left = area.monitorLeftCoordinate;
+	if (intersectionRect.top < area.monitorTopCoordinate)
+		intersectionRect.top = area.monitorTopCoordinate;
+	if (intersectionRect.right > area.monitorLeftCoordinate + area.monitorWidth)
+		intersectionRect.right = area.monitorLeftCoordinate + area.monitorWidth;
+	if (intersectionRect.bottom > area.monitorTopCoordinate + area.monitorHeight)
+		intersectionRect.bottom = area.monitorTopCoordinate + area.monitorHeight;
+
+	// store the occluded area, windows without an intersection are skipped
+	if (intersectionRect.left < intersectionRect.right && intersectionRect.top < intersectionRect.bottom)
+		occlusionData->occludedRects[occlusionData->occludedRectCount++] = intersectionRect;
+
+	return occlusionData->occludedRectCount < MAX_OCCLUDED_RECTS;
+}
+
+double ComputeOcclusionFraction(
+	const OccludedRect *occludedRects,
+	int occludedRectCount,
+	const MonitorInfo &monitor,
+	int sampleStep
+)
+{
+	int occludedCount = 0;
+	int totalSamples = 0;
+
+	// Loop over the monitor's area using the given step size.
+	for (int y = monitor.monitorTopCoordinate; y < monitor.monitorTopCoordinate + monitor.monitorHeight;
+		 y += sampleStep) {
+		for (int x = monitor.monitorLeftCoordinate; x < monitor.monitorLeftCoordinate + monitor.monitorWidth;
+			 x += sampleStep) {
+			totalSamples++;
+			bool isOccluded = false;
+			// Check if this sample point is within any occlusion rectangle.
+			for (int i = 0; i < occludedRectCount; i++) {
+				const OccludedRect &rect = occludedRects[i];
+				if (x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom) {
+					isOccluded = true;
+					break;
+				}
+			}
+			if (isOccluded)
+				occludedCount++;
+		}
+	}
+
+	// Avoid division by zero.
+	if (totalSamples == 0)
+		return 0.0;
+
+	return static_cast<double>(occludedCount) / static_cast<double>(totalSamples);
+}
+
+// Collects the windows covering area into g_occlusionData:
+// the top-level windows of the desktop, or the scripted windows in headless mode.
+static void CollectOccludingWindows(const MonitorInfo &area)
+{
+	g_occlusionData.monitor = area;
+	g_occlusionData.occludedRectCount = 0;
+
+	if (RaylibDesktopIsHeadless()) {
+		MonitorInfo windows[RAYLIB_DESKTOP_MAX_MONITORS];
+		int windowCount = RaylibDesktopHeadlessGetWindows(windows, RAYLIB_DESKTOP_MAX_MONITORS);
+		for (int i = 0; i < windowCount; i++) {
+			const MonitorInfo &window = windows[i];
+			OccludedRect windowRect = {
+				window.monitorLeftCoordinate,
+				window.monitorTopCoordinate,
+				window.monitorLeftCoordinate + window.monitorWidth,
+				window.monitorTopCoordinate + window.monitorHeight
+			};
+			if (!AddOccludedRect(&g_occlusionData, windowRect))
+				break;
+		}
+		return;
+	}
+
+#ifdef _WIN32
+	// g_debugWindows = {};
+
+	// Enumerate all top-level windows.
+	EnumWindows(FullscreenWindowEnumProc, reinterpret_cast<LPARAM>(&g_occlusionData));
+#endif
+}
+
 // Determines whether any fullscreen (or large) window occludes the given monitor area.
 // The monitor's coordinates should be relative to the desktop origin (i.e., (0,0) at the top-left).
 // The occlusionThreshold parameter specifies what fraction of the monitor must be covered
@@ -285,22 +383,50 @@ BOOL CALLBACK FullscreenWindowEnumProc(HWND hwnd, LPARAM lParam)
 // Returns: true if the monitor is occluded; false otherwise.
 bool IsMonitorOccluded(const MonitorInfo &monitor, double occlusionThreshold)
 {
-	FullscreenOcclusionData occlusionData;
-	occlusionData.monitor = monitor;
-	occlusionData.occludedRects = {};
-
-	// g_debugWindows = {};
+	// Return true if the occluded fraction exceeds the threshold.
+	return GetMonitorOcclusionFraction(monitor) >= occlusionThreshold;
+}
 
-	// Enumerate all top-level windows.
-	EnumWindows(FullscreenWindowEnumProc, reinterpret_cast<LPARAM>(&occlusionData));
+// Computes the fraction of the given monitor area covered by other top-level windows.
+double GetMonitorOcclusionFraction(const MonitorInfo &monitor)
+{
+	CollectOccludingWindows(monitor);
 
 	// Calculate the fraction of the monitor that is occluded.
-	double occludedFraction = ComputeOcclusionFraction(occlusionData.occludedRects, monitor);
+	return ComputeOcclusionFraction(g_occlusionData.occludedRects, g_occlusionData.occludedRectCount, monitor);
+}
 
-	// Return true if the occluded fraction exceeds the threshold.
-	return occludedFraction >= occlusionThreshold;
+// Enumerates the windows once over the bounding box of all monitors,
+// then measures each monitor against the same rectangles.
+void GetMonitorOcclusionFractions(const MonitorInfo *monitors, int monitorCount, double *fractions)
+{
+	if (monitorCount <= 0)
+		return;
+
+	int left = monitors[0].monitorLeftCoordinate;
+	int top = monitors[0].monitorTopCoordinate;
+	int right = left + monitors[0].monitorWidth;
+	int bottom = top + monitors[0].monitorHeight;
+	for (int i = 1; i < monitorCount; i++) {
+		const MonitorInfo &monitor = monitors[i];
+		if (monitor.monitorLeftCoordinate < left)
+			left = monitor.monitorLeftCoordinate;
+		if (monitor.monitorTopCoordinate < top)
+			top = monitor.monitorTopCoordinate;
+		if (monitor.monitorLeftCoordinate + monitor.monitorWidth > right)
+			right = monitor.monitorLeftCoordinate + monitor.monitorWidth;
+		if (monitor.monitorTopCoordinate + monitor.monitorHeight > bottom)
+			bottom = monitor.monitorTopCoordinate + monitor.monitorHeight;
+	}
+
+	CollectOccludingWindows({left, top, right - left, bottom - top});
+
+	for (int i = 0; i < monitorCount; i++)
+		fractions[i] =
+			ComputeOcclusionFraction(g_occlusionData.occludedRects, g_occlusionData.occludedRectCount, monitors[i]);
 }
 
+#ifdef _WIN32
 // Callback function for EnumWindows to locate the proper WorkerW window
 BOOL CALLBACK EnumWindowsProc(HWND windowHandle, LPARAM lParam)
 {
@@ -313,9 +439,11 @@ BOOL CALLBACK EnumWindowsProc(HWND windowHandle, LPARAM lParam)
 	}
 	return TRUE;
 }
+#endif
 
 int InitRaylibDesktop()
 {
+#ifdef _WIN32
 	// Set the process DPI awareness to get physical pixel coordinates.
 	// This must be done before any windows are created.
 	HRESULT dpiAwarenessResult = SetProcessDpiAwareness(PROCESS_PER_MONITOR_DPI_AWARE);
@@ -354,10 +482,19 @@ int InitRaylibDesktop()
 	}
 
 	return 0;
+#else
+	fprintf(stderr, "RaylibDesktop: only headless mode is supported on this platform\n");
+	return -1;
+#endif
 }
 
 void RaylibDesktopReparentWindow(void *raylibWindowHandle)
 {
+	// There is no desktop to attach to
+	if (RaylibDesktopIsHeadless())
+		return;
+
+#ifdef _WIN32
 	g_raylibWindowHandle = (HWND)raylibWindowHandle;
 
 	// Prepare the raylib window to be a layered child of Progman
@@ -385,12 +522,19 @@ void RaylibDesktopReparentWindow(void *raylibWindowHandle)
 	}
 
 	RedrawWindow(g_raylibWindowHandle, NULL, NULL, RDW_INVALIDATE | RDW_UPDATENOW);
+#else
+	(void)raylibWindowHandle;
+#endif
 }
 
 void ConfigureDesktopPositioning(MonitorInfo monitorInfo)
 {
 	g_selectedMonitor = monitorInfo;
 
+	if (RaylibDesktopIsHeadless())
+		return;
+
+#ifdef _WIN32
 	// SetWindowPos(g_raylibWindowHandle, NULL, 0, 0, monitorInfo.monitorWidth, monitorInfo.monitorHeight, SWP_NOZORDER
 	// | SWP_NOACTIVATE);
 
@@ -405,8 +549,10 @@ void ConfigureDesktopPositioning(MonitorInfo monitorInfo)
 		monitorInfo.monitorHeight,
 		SWP_NOZORDER | SWP_NOACTIVATE
 	);
+#endif
 }
 
+#ifdef _WIN32
 struct DesktopCloser
 {
 	void operator()(HDESK h) const noexcept
@@ -444,15 +590,24 @@ static bool IsSecureDesktop()
 	if (bytes == 0)
 		return true; // shouldn’t happen, but stay conservative
 
-	std::vector<wchar_t> name((bytes / sizeof(wchar_t)) + 1, L'\0');
-	if (!GetUserObjectInformationW(desktop.get(), UOI_NAME, name.data(), bytes, &bytes))
+	// Desktop names that don't fit can't be "Default", so a fixed buffer is enough
+	wchar_t name[64] = {0};
+	if (bytes > sizeof(name) - sizeof(wchar_t))
+		return true;
+
+	if (!GetUserObjectInformationW(desktop.get(), UOI_NAME, name, bytes, &bytes))
 		return true;
 
-	return _wcsicmp(name.data(), L"Default") != 0;
+	return _wcsicmp(name, L"Default") != 0;
 }
+#endif
 
 bool IsDesktopLocked()
 {
+	if (RaylibDesktopIsHeadless())
+		return RaylibDesktopHeadlessIsDesktopLocked();
+
+#ifdef _WIN32
 	if (IsSecureDesktop())
 		return true;
 
@@ -475,16 +630,119 @@ bool IsDesktopLocked()
 		return false;
 
 	return _wcsicmp(PathFindFileNameW(path), L"LockApp.exe") == 0;
+#else
+	return false;
+#endif
+}
+
+#ifdef _WIN32
+// Returns true when the shell reports a fullscreen app, game or presentation.
+static bool IsUserBusy()
+{
+	QUERY_USER_NOTIFICATION_STATE state;
+	if (FAILED(SHQueryUserNotificationState(&state)))
+		return false;
+
+	switch (state) {
+	case QUNS_BUSY: // Fullscreen app
+	case QUNS_RUNNING_D3D_FULL_SCREEN: // Fullscreen Direct3D game
+	case QUNS_PRESENTATION_MODE: // Presentation settings are on
+		return true;
+	default:
+		return false;
+	}
+}
+#endif
+
+void RaylibDesktopQueryPolicyInputs(const MonitorInfo &monitor, RaylibDesktopPolicyInputs *inputs)
+{
+	inputs->onBattery = false;
+	inputs->batterySaver = false;
+	inputs->batteryPercent = -1;
+	inputs->userBusy = false;
+	inputs->occlusionFraction = GetMonitorOcclusionFraction(monitor);
+	inputs->inputIdleSeconds = 0.0;
+
+	// The power, busy and idle inputs of a headless desktop come from the timeline
+	if (RaylibDesktopIsHeadless()) {
+		RaylibDesktopHeadlessGetPolicyInputs(inputs);
+		return;
+	}
+
+#ifdef _WIN32
+	SYSTEM_POWER_STATUS powerStatus;
+	if (GetSystemPowerStatus(&powerStatus)) {
+		// ACLineStatus is 255 when unknown, treat that as AC power
+		inputs->onBattery = powerStatus.ACLineStatus == 0;
+		inputs->batterySaver = powerStatus.SystemStatusFlag == 1;
+		if (powerStatus.BatteryLifePercent != 255) {
+			inputs->batteryPercent = powerStatus.BatteryLifePercent;
+		}
+	}
+
+	inputs->userBusy = IsUserBusy();
+
+	LASTINPUTINFO lastInput;
+	lastInput.cbSize = sizeof(LASTINPUTINFO);
+	if (GetLastInputInfo(&lastInput)) {
+		// Unsigned subtraction handles the 49.7 day tick count wrap around
+		DWORD idleMilliseconds = GetTickCount() - lastInput.dwTime;
+		inputs->inputIdleSeconds = idleMilliseconds / 1000.0;
+	}
+#endif
+}
+
+void RaylibDesktopGetProcessStats(double *cpuSeconds, size_t *peakMemoryBytes)
+{
+#ifdef _WIN32
+	*cpuSeconds = 0.0;
+	*peakMemoryBytes = 0;
+
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+		ULARGE_INTEGER kernel, user;
+		kernel.LowPart = kernelTime.dwLowDateTime;
+		kernel.HighPart = kernelTime.dwHighDateTime;
+		user.LowPart = userTime.dwLowDateTime;
+		user.HighPart = userTime.dwHighDateTime;
+
+		// FILETIME counts 100 ns intervals
+		*cpuSeconds = (kernel.QuadPart + user.QuadPart) / 1e7;
+	}
+
+	PROCESS_MEMORY_COUNTERS memoryCounters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters))) {
+		*peakMemoryBytes = memoryCounters.PeakWorkingSetSize;
+	}
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+
+	*cpuSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec +
+				  usage.ru_stime.tv_usec / 1e6;
+
+#ifdef __APPLE__
+	*peakMemoryBytes = static_cast<size_t>(usage.ru_maxrss); // bytes on macOS
+#else
+	*peakMemoryBytes = static_cast<size_t>(usage.ru_maxrss) * 1024; // kilobytes on Linux
+#endif
+#endif
 }
 
 void CleanupRaylibDesktop()
 {
+	// The wallpaper was never replaced
+	if (RaylibDesktopIsHeadless())
+		return;
+
+#ifdef _WIN32
 	wchar_t wallpaperPath[MAX_PATH] = {0};
 	// Retrieve the current wallpaper path
 	if (SystemParametersInfo(SPI_GETDESKWALLPAPER, MAX_PATH, wallpaperPath, 0)) {
 		// Reapply the wallpaper to force a refresh.
 		SystemParametersInfo(SPI_SETDESKWALLPAPER, 0, wallpaperPath, SPIF_UPDATEINIFILE | SPIF_SENDCHANGE);
 	}
+#endif
 }
 
 // Mouse replacement
@@ -505,6 +763,7 @@ typedef struct Vector2
 static bool prevMouseState[MOUSE_BUTTON_COUNT] = {false, false, false, false, false};
 static bool currMouseState[MOUSE_BUTTON_COUNT] = {false, false, false, false, false};
 
+#ifdef _WIN32
 // Helper function: maps a button index to the corresponding virtual key.
 static int GetVirtualKeyForMouseButton(int button)
 {
@@ -523,11 +782,23 @@ static int GetVirtualKeyForMouseButton(int button)
 		return 0; // Invalid button index
 	}
 }
+#endif
 
 // UpdateMouseState() should be called once per frame.
 // It copies the current state into previous state, then queries the current state.
 void RaylibDesktopUpdateMouseState(void)
 {
+	// Headless mode replays the scripted buttons and advances the timeline
+	if (RaylibDesktopIsHeadless()) {
+		RaylibDesktopHeadlessAdvanceFrame();
+		for (int i = 0; i < MOUSE_BUTTON_COUNT; i++) {
+			prevMouseState[i] = currMouseState[i];
+			currMouseState[i] = RaylibDesktopHeadlessIsMouseButtonDown(i);
+		}
+		return;
+	}
+
+#ifdef _WIN32
 	for (int i = 0; i < MOUSE_BUTTON_COUNT; i++) {
 		prevMouseState[i] = currMouseState[i];
 		int vk = GetVirtualKeyForMouseButton(i);
@@ -539,6 +810,7 @@ void RaylibDesktopUpdateMouseState(void)
 			currMouseState[i] = false;
 		}
 	}
+#endif
 }
 
 // Returns true if the mouse button was pressed this frame (down now but was up previously)
@@ -573,21 +845,32 @@ bool RaylibDesktopIsMouseButtonUp(int button)
 	return !currMouseState[button];
 }
 
-bool GetRelativeCursorPos(POINT *p)
+// Cursor position relative to the selected monitor
+static bool GetRelativeCursorPos(int *x, int *y)
 {
 	int selectedMonitorX = g_selectedMonitor.monitorLeftCoordinate;
 	int selectedMonitorY = g_selectedMonitor.monitorTopCoordinate;
 
-	if (GetCursorPos(p)) {
+	if (RaylibDesktopIsHeadless()) {
+		RaylibDesktopHeadlessGetCursorPos(x, y);
+		*x -= selectedMonitorX;
+		*y -= selectedMonitorY;
+		return true;
+	}
+
+#ifdef _WIN32
+	POINT p;
+	if (GetCursorPos(&p)) {
 		// Convert to desktop coordinates
-		p->x -= g_desktopX;
-		p->y -= g_desktopY;
+		p.x -= g_desktopX;
+		p.y -= g_desktopY;
 
 		// Convert to window coordinates
-		p->x -= selectedMonitorX;
-		p->y -= selectedMonitorY;
+		*x = p.x - selectedMonitorX;
+		*y = p.y - selectedMonitorY;
 		return true;
 	}
+#endif
 
 	return false;
 }
@@ -595,28 +878,28 @@ bool GetRelativeCursorPos(POINT *p)
 // GetMouseX() and GetMouseY() return the global cursor position in physical pixels.
 int RaylibDesktopGetMouseX(void)
 {
-	POINT p;
-	if (GetRelativeCursorPos(&p))
-		return p.x;
+	int x, y;
+	if (GetRelativeCursorPos(&x, &y))
+		return x;
 	return 0;
 }
 
 int RaylibDesktopGetMouseY(void)
 {
-	POINT p;
-	if (GetRelativeCursorPos(&p))
-		return p.y;
+	int x, y;
+	if (GetRelativeCursorPos(&x, &y))
+		return y;
 	return 0;
 }
 
 // GetMousePosition() returns a Vector2 with the cursor's x and y coordinates.
 Vector2 RaylibDesktopGetMousePosition(void)
 {
-	POINT p;
+	int x, y;
 	Vector2 pos = {0.0f, 0.0f};
-	if (GetRelativeCursorPos(&p)) {
-		pos.x = (float)p.x;
-		pos.y = (float)p.y;
+	if (GetRelativeCursorPos(&x, &y)) {
+		pos.x = (float)x;
+		pos.y = (float)y;
 	}
 	return pos;
 }
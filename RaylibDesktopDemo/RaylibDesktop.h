@@ -1,10 +1,20 @@
 #pragma once
 #include <vector>
 
+#include "RaylibDesktopPolicy.h"
+
 // Call this function to initialize the desktop window.
 int InitRaylibDesktop();
 
 // Monitor setup
+// Maximum number of monitors enumerated, monitors past this count are left out of the enumeration
+// (the desktop origin and GetWallpaperTarget(-1) still cover the whole virtual screen)
+#define RAYLIB_DESKTOP_MAX_MONITORS 16
+
+// Maximum number of windows the occlusion functions track per query. Once a query finds this many
+// occluding windows the remaining ones are ignored, so the occlusion can be underestimated.
+#define RAYLIB_DESKTOP_MAX_OCCLUDING_WINDOWS 256
+
 // Structure to hold information about a monitor
 typedef struct MonitorInfo
 {
@@ -17,6 +27,10 @@ typedef struct MonitorInfo
 // Enumerate all monitors and return their information
 std::vector<MonitorInfo> EnumerateAllMonitors();
 
+// Enumerate all monitors into the caller's buffer without allocating
+// Returns the number of monitors written (at most capacity and RAYLIB_DESKTOP_MAX_MONITORS)
+int RaylibDesktopGetMonitors(MonitorInfo *monitors, int capacity);
+
 // pass -1 to get the entire desktop
 MonitorInfo GetWallpaperTarget(int monitorIndex);
 
@@ -24,11 +38,23 @@ MonitorInfo GetWallpaperTarget(int monitorIndex);
 void ConfigureDesktopPositioning(MonitorInfo monitorInfo);
 
 // Monitor Occlusion Detection
+// The occlusion functions share one window buffer to avoid allocating every frame, so they are not
+// reentrant or thread safe: only call them from one thread at a time (usually the render thread).
 bool IsMonitorOccluded(const MonitorInfo &monitor, double occlusionThreshold = 0.95);
 
+// Returns the fraction of the monitor area covered by other windows (0.0 - 1.0)
+double GetMonitorOcclusionFraction(const MonitorInfo &monitor);
+
+// Computes the occluded fraction of several monitors with a single pass over the top-level windows
+void GetMonitorOcclusionFractions(const MonitorInfo *monitors, int monitorCount, double *fractions);
+
 // Check if desktop is occluded by Lock/Secure screen
 bool IsDesktopLocked();
 
+// Fills the quality policy inputs for the given wallpaper target from the power status,
+// the user notification state (fullscreen apps, presentations), occlusion and the last input time.
+void RaylibDesktopQueryPolicyInputs(const MonitorInfo &monitor, RaylibDesktopPolicyInputs *inputs);
+
 // Call this function to reparent the raylib window to the desktop after raylib has created its own.
 void RaylibDesktopReparentWindow(void *raylibWindowHandle);
 
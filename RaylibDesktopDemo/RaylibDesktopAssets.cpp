@@ -0,0 +1,363 @@
+#include "RaylibDesktopAssets.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rlgl.h"
+
+// Lifecycle of a cache entry
+// Queued -> Decoding -> Decoded (uploading stripes) -> Uploaded
+// Failed entries are kept so the same file isn't decoded over and over.
+enum AssetState
+{
+	ASSET_QUEUED,
+	ASSET_DECODING,
+	ASSET_DECODED,
+	ASSET_UPLOADED,
+	ASSET_FAILED
+};
+
+struct AssetEntry
+{
+	std::string fileName;
+	AssetState state = ASSET_QUEUED;
+
+	Image image = {0}; // Decoded pixels, kept while the entry is cached
+	size_t bytes = 0; // Size of the decoded pixels
+
+	Texture2D texture = {0}; // GPU texture, valid once state is ASSET_UPLOADED
+	int uploadedRows = 0; // Rows already copied to the texture
+
+	bool pinned = false; // Part of the current slideshow window, never evicted
+	bool uploading = false; // Main thread is reading image, never evicted
+	bool inLru = false;
+	std::list<AssetEntry *>::iterator lruPosition;
+};
+
+// Loader state, all of it is protected by g_assetMutex
+static std::mutex g_assetMutex;
+static std::condition_variable g_assetCondition;
+static std::vector<std::thread> g_assetWorkers;
+static bool g_assetStop = false;
+
+static size_t g_cacheBudgetBytes = 0;
+static size_t g_cachedBytes = 0;
+
+// std::less<> allows looking up entries by const char * without building a std::string
+static std::map<std::string, AssetEntry, std::less<>> g_assetEntries;
+
+// Decoded entries, most recently used first
+static std::list<AssetEntry *> g_assetLru;
+
+// Entries waiting for a decode thread, highest priority first
+static std::deque<AssetEntry *> g_decodeQueue;
+
+// Decoded entries waiting for the main thread to upload them, in decode order
+static std::deque<AssetEntry *> g_uploadQueue;
+
+// Textures of evicted entries, unloaded on the main thread
+static std::vector<Texture2D> g_texturesToUnload;
+
+static RaylibDesktopAssetLoaderStats g_assetStats = {0};
+
+// Removes entries from the back of the LRU until the cache fits its budget.
+// Pinned and uploading entries are skipped, so the cache may stay above its budget
+// when the slideshow window alone doesn't fit. The entry that was just decoded (keep) is
+// skipped too, otherwise it could be evicted before it is uploaded and decoded again on the next request.
+static void EvictImages(const AssetEntry *keep)
+{
+	auto it = g_assetLru.end();
+	while (g_cachedBytes > g_cacheBudgetBytes && it != g_assetLru.begin()) {
+		--it;
+		AssetEntry *entry = *it;
+		if (entry->pinned || entry->uploading || entry == keep)
+			continue;
+
+		it = g_assetLru.erase(it);
+
+		UnloadImage(entry->image);
+		g_cachedBytes -= entry->bytes;
+
+		if (entry->texture.id != 0) {
+			g_texturesToUnload.push_back(entry->texture);
+		}
+
+		auto queued = std::find(g_uploadQueue.begin(), g_uploadQueue.end(), entry);
+		if (queued != g_uploadQueue.end()) {
+			g_uploadQueue.erase(queued);
+		}
+
+		g_assetStats.evictedImages++;
+		g_assetEntries.erase(entry->fileName);
+	}
+}
+
+static void AssetWorkerProc()
+{
+	std::unique_lock<std::mutex> lock(g_assetMutex);
+
+	while (true) {
+		g_assetCondition.wait(lock, [] { return g_assetStop || !g_decodeQueue.empty(); });
+		if (g_assetStop)
+			return;
+
+		AssetEntry *entry = g_decodeQueue.front();
+		g_decodeQueue.pop_front();
+		entry->state = ASSET_DECODING;
+
+		// Decoding doesn't touch any shared state, the entry can't be erased while it is decoding
+		lock.unlock();
+		Image image = LoadImage(entry->fileName.c_str());
+		lock.lock();
+
+		if (image.data == NULL) {
+			entry->state = ASSET_FAILED;
+			g_assetStats.failedImages++;
+			continue;
+		}
+
+		entry->image = image;
+		entry->bytes = GetPixelDataSize(image.width, image.height, image.format);
+		entry->state = ASSET_DECODED;
+		entry->lruPosition = g_assetLru.insert(g_assetLru.begin(), entry);
+		entry->inLru = true;
+
+		g_cachedBytes += entry->bytes;
+		g_assetStats.decodedImages++;
+		g_uploadQueue.push_back(entry);
+
+		EvictImages(entry);
+	}
+}
+
+void InitRaylibDesktopAssetLoader(const RaylibDesktopAssetLoaderConfig *config)
+{
+	int workerCount = config ? config->workerCount : 0;
+	if (workerCount <= 0) {
+		// Leave a core for the render thread and one for the rest of the desktop
+		int cpuCount = static_cast<int>(std::thread::hardware_concurrency());
+		workerCount = std::max(1, cpuCount - 2);
+	}
+
+	g_cacheBudgetBytes = (config && config->cacheBudgetBytes > 0) ? config->cacheBudgetBytes : 512u * 1024u * 1024u;
+	g_assetStop = false;
+	g_assetStats = {0};
+
+	// Start with a conservative upload throughput, it is measured as stripes are uploaded
+	g_assetStats.uploadBytesPerSecond = 256.0 * 1024.0 * 1024.0;
+
+	for (int i = 0; i < workerCount; i++) {
+		g_assetWorkers.emplace_back(AssetWorkerProc);
+	}
+}
+
+void CleanupRaylibDesktopAssetLoader(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(g_assetMutex);
+		g_assetStop = true;
+	}
+	g_assetCondition.notify_all();
+
+	for (std::thread &worker : g_assetWorkers) {
+		worker.join();
+	}
+	g_assetWorkers.clear();
+
+	for (auto &pair : g_assetEntries) {
+		AssetEntry &entry = pair.second;
+		if (entry.image.data != NULL)
+			UnloadImage(entry.image);
+		if (entry.texture.id != 0)
+			UnloadTexture(entry.texture);
+	}
+	for (Texture2D &texture : g_texturesToUnload) {
+		UnloadTexture(texture);
+	}
+
+	g_assetEntries.clear();
+	g_assetLru.clear();
+	g_decodeQueue.clear();
+	g_uploadQueue.clear();
+	g_texturesToUnload.clear();
+	g_cachedBytes = 0;
+}
+
+// Looks up or creates the entry for fileName and moves it to the front of the decode queue
+// if it still waits for a decode thread. Must be called with g_assetMutex held.
+static AssetEntry *RequestImageLocked(const char *fileName)
+{
+	auto found = g_assetEntries.find(fileName);
+	if (found != g_assetEntries.end()) {
+		AssetEntry *entry = &found->second;
+		if (entry->state == ASSET_QUEUED) {
+			auto queued = std::find(g_decodeQueue.begin(), g_decodeQueue.end(), entry);
+			if (queued != g_decodeQueue.end()) {
+				g_decodeQueue.erase(queued);
+			}
+			g_decodeQueue.push_front(entry);
+		}
+		return entry;
+	}
+
+	AssetEntry *entry = &g_assetEntries[fileName];
+	entry->fileName = fileName;
+	g_decodeQueue.push_front(entry);
+	return entry;
+}
+
+void RaylibDesktopRequestImage(const char *fileName)
+{
+	{
+		std::lock_guard<std::mutex> lock(g_assetMutex);
+		RequestImageLocked(fileName);
+	}
+	g_assetCondition.notify_one();
+}
+
+void RaylibDesktopPrefetchSlides(const char *const *fileNames, int count, int currentIndex, int prefetchCount)
+{
+	if (count <= 0)
+		return;
+
+	prefetchCount = std::min(prefetchCount, count - 1);
+
+	{
+		std::lock_guard<std::mutex> lock(g_assetMutex);
+
+		for (auto &pair : g_assetEntries) {
+			pair.second.pinned = false;
+		}
+
+		// Request the furthest slide first, every request moves to the front of the queue,
+		// so the current slide ends up being decoded first.
+		for (int i = prefetchCount; i >= 0; i--) {
+			int index = ((currentIndex + i) % count + count) % count;
+			AssetEntry *entry = RequestImageLocked(fileNames[index]);
+			entry->pinned = true;
+		}
+
+		// Unpinned entries may now be over budget
+		EvictImages(NULL);
+	}
+	g_assetCondition.notify_all();
+}
+
+int RaylibDesktopUploadImages(double budgetSeconds)
+{
+	int readyCount = 0;
+	double startTime = GetTime();
+
+	std::unique_lock<std::mutex> lock(g_assetMutex);
+
+	for (Texture2D &texture : g_texturesToUnload) {
+		UnloadTexture(texture);
+	}
+	g_texturesToUnload.clear();
+
+	while (!g_uploadQueue.empty()) {
+		double remainingSeconds = budgetSeconds - (GetTime() - startTime);
+		if (remainingSeconds <= 0.0)
+			break;
+
+		AssetEntry *entry = g_uploadQueue.front();
+		Image image = entry->image;
+		size_t rowBytes = entry->bytes / image.height;
+
+		// Compressed or mipmapped images can't be split in rows, upload them in one go
+		bool canStripe = image.mipmaps == 1 && image.format < PIXELFORMAT_COMPRESSED_DXT1_RGB;
+
+		int rowCount = image.height - entry->uploadedRows;
+		if (canStripe) {
+			// Upload as many rows as the measured throughput allows in the remaining budget,
+			// but at least a few so every frame makes progress.
+			double budgetBytes = remainingSeconds * g_assetStats.uploadBytesPerSecond;
+			int budgetRows = static_cast<int>(budgetBytes / static_cast<double>(rowBytes));
+			rowCount = std::min(rowCount, std::max(budgetRows, 16));
+		}
+
+		// The image can't be evicted while it is uploading, so it can be read without the lock
+		entry->uploading = true;
+		lock.unlock();
+
+		double uploadStart = GetTime();
+		Texture2D texture = entry->texture;
+		if (!canStripe) {
+			texture = LoadTextureFromImage(image);
+		}
+		else {
+			if (texture.id == 0) {
+				// Allocate the texture storage without any data, the rows are copied below
+				texture.id = rlLoadTexture(NULL, image.width, image.height, image.format, 1);
+				texture.width = image.width;
+				texture.height = image.height;
+				texture.mipmaps = 1;
+				texture.format = image.format;
+			}
+
+			Rectangle rows = {
+				0.0f, static_cast<float>(entry->uploadedRows), static_cast<float>(image.width),
+				static_cast<float>(rowCount)
+			};
+			const unsigned char *pixels = static_cast<const unsigned char *>(image.data) + entry->uploadedRows * rowBytes;
+			UpdateTextureRec(texture, rows, pixels);
+		}
+		double uploadSeconds = GetTime() - uploadStart;
+
+		lock.lock();
+		entry->uploading = false;
+		entry->texture = texture;
+		entry->uploadedRows = canStripe ? entry->uploadedRows + rowCount : image.height;
+
+		// Smooth the throughput estimate, single stripes are too noisy to use directly
+		if (canStripe && uploadSeconds > 0.0) {
+			double bytesPerSecond = static_cast<double>(rowCount * rowBytes) / uploadSeconds;
+			g_assetStats.uploadBytesPerSecond = g_assetStats.uploadBytesPerSecond * 0.75 + bytesPerSecond * 0.25;
+		}
+
+		if (entry->uploadedRows >= image.height) {
+			entry->state = ASSET_UPLOADED;
+			g_uploadQueue.pop_front();
+			readyCount++;
+		}
+	}
+
+	return readyCount;
+}
+
+bool RaylibDesktopGetImageTexture(const char *fileName, Texture2D *texture)
+{
+	std::lock_guard<std::mutex> lock(g_assetMutex);
+
+	auto found = g_assetEntries.find(fileName);
+	if (found == g_assetEntries.end() || found->second.state != ASSET_UPLOADED)
+		return false;
+
+	// Mark as most recently used
+	AssetEntry &entry = found->second;
+	if (entry.inLru) {
+		g_assetLru.splice(g_assetLru.begin(), g_assetLru, entry.lruPosition);
+	}
+
+	*texture = entry.texture;
+	return true;
+}
+
+RaylibDesktopAssetLoaderStats RaylibDesktopGetAssetLoaderStats(void)
+{
+	std::lock_guard<std::mutex> lock(g_assetMutex);
+
+	RaylibDesktopAssetLoaderStats stats = g_assetStats;
+	stats.cachedImages = static_cast<int>(g_assetLru.size());
+	stats.cachedBytes = g_cachedBytes;
+	stats.queuedImages = static_cast<int>(g_decodeQueue.size());
+	return stats;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <stddef.h>
+
+#include "raylib.h"
+
+// Asynchronous asset loader
+// Decodes images on worker threads into a byte-budgeted LRU cache of CPU images,
+// and uploads them to the GPU on the main thread within a per-frame time budget.
+// Useful for slideshows where decoding large images on the render thread causes hitches.
+// Unlike RaylibDesktop.h this header includes raylib.h, it doesn't depend on windows.h.
+
+typedef struct RaylibDesktopAssetLoaderConfig
+{
+	int workerCount; // Number of decode threads, 0 picks one based on the CPU count
+	size_t cacheBudgetBytes; // Maximum size of the decoded images kept in memory
+} RaylibDesktopAssetLoaderConfig;
+
+typedef struct RaylibDesktopAssetLoaderStats
+{
+	int cachedImages; // Decoded images currently held in the cache
+	size_t cachedBytes; // Size of the decoded images currently held in the cache
+	int queuedImages; // Images waiting to be decoded
+	int decodedImages; // Total number of images decoded
+	int evictedImages; // Total number of images evicted from the cache
+	int failedImages; // Total number of images that failed to load
+	double uploadBytesPerSecond; // Measured texture upload throughput
+} RaylibDesktopAssetLoaderStats;
+
+// Call this function to start the decode threads.
+// Pass NULL to use the defaults (CPU count based workers, 512 MB cache).
+void InitRaylibDesktopAssetLoader(const RaylibDesktopAssetLoaderConfig *config);
+
+// Call this function to stop the decode threads and unload all images and textures.
+// Must be called on the main thread before CloseWindow().
+void CleanupRaylibDesktopAssetLoader(void);
+
+// Queues an image for decoding and upload, does nothing if it is already cached or queued.
+void RaylibDesktopRequestImage(const char *fileName);
+
+// Slideshow helper: requests the current slide and the next prefetchCount slides (wrapping around),
+// in that order of priority. These slides are kept in the cache until the next call.
+void RaylibDesktopPrefetchSlides(const char *const *fileNames, int count, int currentIndex, int prefetchCount);
+
+// Call this function once per frame on the main thread.
+// Uploads decoded images to the GPU in row stripes until budgetSeconds are spent,
+// and unloads the textures of evicted images.
+// Returns the number of textures that became ready.
+int RaylibDesktopUploadImages(double budgetSeconds);
+
+// Returns true and sets texture if the image is fully uploaded.
+// The texture is owned by the loader, it stays valid until the image is evicted from the cache.
+bool RaylibDesktopGetImageTexture(const char *fileName, Texture2D *texture);
+
+// Returns the current cache and loader counters
+RaylibDesktopAssetLoaderStats RaylibDesktopGetAssetLoaderStats(void);
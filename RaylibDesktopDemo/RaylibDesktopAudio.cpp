@@ -0,0 +1,628 @@
+#include "RaylibDesktopAudio.h"
+#include "RaylibDesktopAudioFft.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+// Keep std::min and std::max usable
+#define NOMINMAX
+#include <Windows.h>
+#include <memory>
+
+// For loopback capture
+#include <audioclient.h>
+#include <ksmedia.h>
+#include <mmdeviceapi.h>
+#pragma comment(lib, "Ole32.lib")
+#endif
+
+static double GetAudioClockSeconds()
+{
+	static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double RaylibDesktopGetAudioTime(void)
+{
+	return GetAudioClockSeconds();
+}
+
+RaylibDesktopAudioConfig RaylibDesktopDefaultAudioConfig(void)
+{
+	RaylibDesktopAudioConfig config;
+	config.fftSize = 2048;
+	config.bandCount = 32;
+	config.minFrequency = 30.0f;
+	config.maxFrequency = 16000.0f;
+	config.attack = 0.6f;
+	config.release = 0.15f;
+	return config;
+}
+
+// Sample ring
+// Single producer (capture thread), single consumer (analysis thread).
+// The producer drops samples when the ring is full instead of blocking the capture.
+struct SampleRing
+{
+	std::vector<float> samples; // Capacity is a power of two
+	uint64_t mask = 0;
+	std::atomic<uint64_t> writeIndex {0}; // Total samples written, owned by the producer
+	std::atomic<uint64_t> readIndex {0}; // Oldest sample still needed, owned by the consumer
+	std::vector<double> writeTimes; // Clock time of each write, stored at the ring position of its last sample
+	std::atomic<uint64_t> droppedSamples {0};
+
+	void Reset(size_t capacity)
+	{
+		size_t size = 1;
+		while (size < capacity)
+			size <<= 1;
+		samples.assign(size, 0.0f);
+		writeTimes.assign(size, 0.0);
+		mask = size - 1;
+		writeIndex = 0;
+		readIndex = 0;
+		droppedSamples = 0;
+	}
+
+	void Write(const float *data, size_t count)
+	{
+		uint64_t write = writeIndex.load(std::memory_order_relaxed);
+		uint64_t read = readIndex.load(std::memory_order_acquire);
+		size_t space = samples.size() - static_cast<size_t>(write - read);
+
+		if (count > space) {
+			droppedSamples.fetch_add(count - space, std::memory_order_relaxed);
+			count = space;
+		}
+
+		if (count == 0)
+			return;
+
+		for (size_t i = 0; i < count; i++) {
+			samples[(write + i) & mask] = data[i];
+		}
+
+		// Published with the samples, the slot is only reused once the consumer has moved past it
+		writeTimes[(write + count - 1) & mask] = GetAudioClockSeconds();
+		writeIndex.store(write + count, std::memory_order_release);
+	}
+
+	// Capture time of the write ending at end, a value of writeIndex the consumer has acquired
+	double WriteTime(uint64_t end) const
+	{
+		return writeTimes[(end - 1) & mask];
+	}
+};
+
+
+// Spectrum hand-off
+// Triple buffer: the analysis thread fills the back buffer and swaps it with the middle one,
+// the render thread swaps the middle buffer with its front buffer when a new one is available.
+// Neither side ever waits for the other.
+#define SPECTRUM_DIRTY 4
+
+struct SpectrumTripleBuffer
+{
+	RaylibDesktopAudioSpectrum buffers[3];
+	std::atomic<int> middle {1}; // Index of the middle buffer, ORed with SPECTRUM_DIRTY when unread
+	int back = 0; // Owned by the analysis thread
+	int front = 2; // Owned by the render thread
+
+	void Reset()
+	{
+		memset(buffers, 0, sizeof(buffers));
+		middle = 1;
+		back = 0;
+		front = 2;
+	}
+
+	void Publish()
+	{
+		back = middle.exchange(back | SPECTRUM_DIRTY, std::memory_order_acq_rel) & 3;
+	}
+
+	bool Acquire()
+	{
+		if (!(middle.load(std::memory_order_relaxed) & SPECTRUM_DIRTY))
+			return false;
+		front = middle.exchange(front, std::memory_order_acq_rel) & 3;
+		return true;
+	}
+};
+
+// Module state
+static RaylibDesktopAudioConfig g_audioConfig;
+static int g_audioSampleRate = 0;
+static SampleRing g_audioRing;
+static SpectrumTripleBuffer g_spectrumBuffer;
+static std::atomic<bool> g_audioStop {false};
+static std::atomic<bool> g_audioPaused {false};
+static std::thread g_captureThread;
+static std::thread g_analysisThread;
+
+// WAV source, converted to mono
+static std::vector<float> g_waveSamples;
+
+static void ApplyConfig(const RaylibDesktopAudioConfig *config)
+{
+	g_audioConfig = config ? *config : RaylibDesktopDefaultAudioConfig();
+
+	int fftSize = 64;
+	while (fftSize < g_audioConfig.fftSize && fftSize < 16384)
+		fftSize <<= 1;
+	g_audioConfig.fftSize = fftSize;
+	g_audioConfig.bandCount = std::min(std::max(g_audioConfig.bandCount, 1), RAYLIB_DESKTOP_MAX_AUDIO_BANDS);
+	g_audioConfig.attack = std::min(std::max(g_audioConfig.attack, 0.01f), 1.0f);
+	g_audioConfig.release = std::min(std::max(g_audioConfig.release, 0.01f), 1.0f);
+}
+
+// Moves value towards target using the attack or release factor
+static float Smooth(float value, float target)
+{
+	float factor = target > value ? g_audioConfig.attack : g_audioConfig.release;
+	return value + (target - value) * factor;
+}
+
+// Maps an amplitude to 0.0 - 1.0 over a 70 dB range
+static float AmplitudeToLevel(float amplitude)
+{
+	const float floorDb = -70.0f;
+	float db = 20.0f * std::log10(std::max(amplitude, 1e-7f));
+	return std::min(std::max((db - floorDb) / -floorDb, 0.0f), 1.0f);
+}
+
+static void AnalysisThreadProc()
+{
+	const int fftSize = g_audioConfig.fftSize;
+	const int hop = fftSize / 2; // 50% overlap
+	const int binCount = fftSize / 2;
+	const int bandCount = g_audioConfig.bandCount;
+
+	RealFft fft;
+	fft.Init(fftSize);
+
+	std::vector<float> samples(fftSize);
+	std::vector<float> magnitudes(binCount);
+
+	// Logarithmically spaced band edges, in bins
+	std::vector<int> bandEdges(bandCount + 1);
+	float binWidth = static_cast<float>(g_audioSampleRate) / fftSize;
+	float maxFrequency = std::min(g_audioConfig.maxFrequency, g_audioSampleRate * 0.5f);
+	float minFrequency = std::min(std::max(g_audioConfig.minFrequency, binWidth), maxFrequency);
+	for (int b = 0; b <= bandCount; b++) {
+		float frequency = minFrequency * std::pow(maxFrequency / minFrequency, static_cast<float>(b) / bandCount);
+		bandEdges[b] = std::min(static_cast<int>(frequency / binWidth), binCount - 1);
+	}
+
+	float bands[RAYLIB_DESKTOP_MAX_AUDIO_BANDS] = {0};
+	float level = 0.0f;
+	unsigned long long sequence = 0;
+	uint64_t lastWindowEnd = 0;
+	double lastPublishTime = GetAudioClockSeconds();
+	const double hopSeconds = static_cast<double>(hop) / g_audioSampleRate;
+
+	while (!g_audioStop.load(std::memory_order_relaxed)) {
+		uint64_t write = g_audioRing.writeIndex.load(std::memory_order_acquire);
+
+		if (g_audioPaused.load(std::memory_order_relaxed)) {
+			// Drop everything captured while paused
+			g_audioRing.readIndex.store(write, std::memory_order_release);
+			lastWindowEnd = write;
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			continue;
+		}
+
+		double captureTime = 0.0;
+		bool haveWindow = write - lastWindowEnd >= static_cast<uint64_t>(hop) && write >= static_cast<uint64_t>(fftSize);
+
+		if (!haveWindow) {
+			// Loopback capture delivers nothing while the device is silent, let the bands fall
+			double now = GetAudioClockSeconds();
+			if (now - lastPublishTime < 2.0 * hopSeconds) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				continue;
+			}
+			std::fill(samples.begin(), samples.end(), 0.0f);
+			captureTime = now;
+		}
+		else {
+			// Always analyse the newest window, a visualiser has no use for stale spectra
+			uint64_t start = write - fftSize;
+			for (int i = 0; i < fftSize; i++) {
+				samples[i] = g_audioRing.samples[(start + i) & g_audioRing.mask];
+			}
+			// The newest sample of the window, later writes don't move its timestamp
+			captureTime = g_audioRing.WriteTime(write);
+			lastWindowEnd = write;
+			g_audioRing.readIndex.store(start + hop, std::memory_order_release);
+		}
+
+		fft.Magnitudes(samples.data(), magnitudes.data());
+
+		for (int b = 0; b < bandCount; b++) {
+			// Average power over the band's bins, narrow low bands use at least one bin
+			int first = bandEdges[b];
+			int last = std::max(bandEdges[b + 1], first + 1);
+			float power = 0.0f;
+			for (int k = first; k < last && k < binCount; k++) {
+				power += magnitudes[k] * magnitudes[k];
+			}
+			float amplitude = std::sqrt(power / (last - first));
+			bands[b] = Smooth(bands[b], AmplitudeToLevel(amplitude));
+		}
+
+		float sumSquares = 0.0f;
+		for (int i = 0; i < fftSize; i++) {
+			sumSquares += samples[i] * samples[i];
+		}
+		level = Smooth(level, AmplitudeToLevel(std::sqrt(sumSquares / fftSize)));
+
+		RaylibDesktopAudioSpectrum &spectrum = g_spectrumBuffer.buffers[g_spectrumBuffer.back];
+		memcpy(spectrum.bands, bands, sizeof(bands));
+		spectrum.bandCount = bandCount;
+		spectrum.level = level;
+		spectrum.captureTime = captureTime;
+		spectrum.publishTime = GetAudioClockSeconds();
+		spectrum.sequence = ++sequence;
+		g_spectrumBuffer.Publish();
+
+		lastPublishTime = spectrum.publishTime;
+	}
+}
+
+// The threads of the previous Init call are only joined by CleanupRaylibDesktopAudio()
+static bool IsAudioRunning()
+{
+	return g_captureThread.joinable() || g_analysisThread.joinable();
+}
+
+// Starts the analysis thread once the capture's sample rate is known
+static void StartAnalysis(int sampleRate)
+{
+	g_audioSampleRate = sampleRate;
+	g_audioPaused = false;
+	g_spectrumBuffer.Reset();
+	g_analysisThread = std::thread(AnalysisThreadProc);
+}
+
+// WAV file source
+
+static uint32_t ReadLittleEndian(const unsigned char *data, int bytes)
+{
+	uint32_t value = 0;
+	for (int i = 0; i < bytes; i++) {
+		value |= static_cast<uint32_t>(data[i]) << (8 * i);
+	}
+	return value;
+}
+
+// Loads a 16 bit PCM or 32 bit float WAV file into g_waveSamples as mono, returns the sample rate or 0 on failure
+static int LoadWaveMono(const char *fileName)
+{
+	FILE *file = fopen(fileName, "rb");
+	if (!file)
+		return 0;
+
+	std::vector<unsigned char> data;
+	unsigned char chunk[4096];
+	size_t read;
+	while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+		data.insert(data.end(), chunk, chunk + read);
+	}
+	fclose(file);
+
+	if (data.size() < 12 || memcmp(&data[0], "RIFF", 4) != 0 || memcmp(&data[8], "WAVE", 4) != 0)
+		return 0;
+
+	int formatTag = 0;
+	int channels = 0;
+	int sampleRate = 0;
+	int bitsPerSample = 0;
+	const unsigned char *samples = NULL;
+	size_t sampleBytes = 0;
+
+	size_t offset = 12;
+	while (offset + 8 <= data.size()) {
+		const unsigned char *header = &data[offset];
+		size_t chunkSize = ReadLittleEndian(header + 4, 4);
+		const unsigned char *body = header + 8;
+		size_t available = std::min(chunkSize, data.size() - offset - 8);
+
+		if (memcmp(header, "fmt ", 4) == 0 && available >= 16) {
+			formatTag = ReadLittleEndian(body, 2);
+			channels = ReadLittleEndian(body + 2, 2);
+			sampleRate = ReadLittleEndian(body + 4, 4);
+			bitsPerSample = ReadLittleEndian(body + 14, 2);
+
+			// WAVE_FORMAT_EXTENSIBLE stores the actual format in the first two bytes of the sub format GUID
+			if (formatTag == 0xFFFE && available >= 26) {
+				formatTag = ReadLittleEndian(body + 24, 2);
+			}
+		}
+		else if (memcmp(header, "data", 4) == 0) {
+			samples = body;
+			sampleBytes = available;
+		}
+
+		// Chunks are padded to an even size
+		offset += 8 + chunkSize + (chunkSize & 1);
+	}
+
+	bool isPcm16 = formatTag == 1 && bitsPerSample == 16;
+	bool isFloat32 = formatTag == 3 && bitsPerSample == 32;
+	if (!samples || channels <= 0 || sampleRate <= 0 || (!isPcm16 && !isFloat32))
+		return 0;
+
+	size_t frameBytes = static_cast<size_t>(channels) * (bitsPerSample / 8);
+	size_t frameCount = sampleBytes / frameBytes;
+
+	g_waveSamples.resize(frameCount);
+	for (size_t i = 0; i < frameCount; i++) {
+		const unsigned char *frame = samples + i * frameBytes;
+		float sum = 0.0f;
+		for (int c = 0; c < channels; c++) {
+			if (isPcm16) {
+				int16_t value = static_cast<int16_t>(ReadLittleEndian(frame + c * 2, 2));
+				sum += value / 32768.0f;
+			}
+			else {
+				float value;
+				memcpy(&value, frame + c * 4, sizeof(value));
+				sum += value;
+			}
+		}
+		g_waveSamples[i] = sum / channels;
+	}
+
+	return frameCount > 0 ? sampleRate : 0;
+}
+
+// Writes the WAV samples to the ring at the file's sample rate, looping at the end
+static void WaveCaptureThreadProc()
+{
+	const size_t total = g_waveSamples.size();
+	size_t position = 0;
+	uint64_t written = 0;
+	double startTime = GetAudioClockSeconds();
+
+	while (!g_audioStop.load(std::memory_order_relaxed)) {
+		uint64_t due = static_cast<uint64_t>((GetAudioClockSeconds() - startTime) * g_audioSampleRate);
+
+		while (written < due) {
+			size_t count = static_cast<size_t>(std::min<uint64_t>(due - written, total - position));
+			g_audioRing.Write(&g_waveSamples[position], count);
+			written += count;
+			position = (position + count) % total;
+		}
+
+		// Deliver in ~5 ms blocks, like a shared mode audio device would
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+}
+
+int InitRaylibDesktopAudioFromWave(const char *fileName, const RaylibDesktopAudioConfig *config)
+{
+	if (IsAudioRunning())
+		return -1;
+
+	ApplyConfig(config);
+
+	int sampleRate = LoadWaveMono(fileName);
+	if (sampleRate == 0)
+		return -1;
+
+	// One second of headroom
+	g_audioRing.Reset(std::max(sampleRate, g_audioConfig.fftSize * 4));
+	g_audioStop = false;
+
+	StartAnalysis(sampleRate);
+	g_captureThread = std::thread(WaveCaptureThreadProc);
+	return 0;
+}
+
+// Loopback source
+
+#ifdef _WIN32
+struct ComReleaser
+{
+	void operator()(IUnknown *p) const noexcept
+	{
+		if (p) {
+			p->Release();
+		}
+	}
+};
+template <typename T>
+using unique_com = std::unique_ptr<T, ComReleaser>;
+
+// Converts one capture packet to mono and writes it to the ring
+static void WriteLoopbackPacket(const BYTE *data, UINT32 frames, const WAVEFORMATEX *format, bool isFloat, bool silent)
+{
+	float mono[1024];
+	UINT32 done = 0;
+
+	while (done < frames) {
+		UINT32 count = std::min<UINT32>(frames - done, 1024);
+		for (UINT32 i = 0; i < count; i++) {
+			float sum = 0.0f;
+			if (!silent) {
+				const BYTE *frame = data + static_cast<size_t>(done + i) * format->nBlockAlign;
+				for (int c = 0; c < format->nChannels; c++) {
+					if (isFloat) {
+						sum += reinterpret_cast<const float *>(frame)[c];
+					}
+					else {
+						sum += reinterpret_cast<const int16_t *>(frame)[c] / 32768.0f;
+					}
+				}
+			}
+			mono[i] = sum / format->nChannels;
+		}
+		g_audioRing.Write(mono, count);
+		done += count;
+	}
+}
+
+// Opens the default render device in loopback mode, reports the sample rate (or 0 on failure)
+// through ready and then captures until g_audioStop is set.
+static void LoopbackCaptureThreadProc(std::promise<int> ready)
+{
+	HRESULT comResult = CoInitializeEx(NULL, COINIT_MULTITHREADED);
+
+	unique_com<IMMDeviceEnumerator> enumerator;
+	unique_com<IMMDevice> device;
+	unique_com<IAudioClient> client;
+	unique_com<IAudioCaptureClient> capture;
+	WAVEFORMATEX *format = NULL;
+	bool isFloat = false;
+
+	{
+		IMMDeviceEnumerator *enumeratorPointer = NULL;
+		IMMDevice *devicePointer = NULL;
+		IAudioClient *clientPointer = NULL;
+		IAudioCaptureClient *capturePointer = NULL;
+
+		if (SUCCEEDED(CoCreateInstance(
+				__uuidof(MMDeviceEnumerator),
+				NULL,
+				CLSCTX_ALL,
+				__uuidof(IMMDeviceEnumerator),
+				reinterpret_cast<void **>(&enumeratorPointer)
+			))) {
+			enumerator.reset(enumeratorPointer);
+		}
+		if (enumerator && SUCCEEDED(enumerator->GetDefaultAudioEndpoint(eRender, eConsole, &devicePointer))) {
+			device.reset(devicePointer);
+		}
+		if (device && SUCCEEDED(device->Activate(
+						  __uuidof(IAudioClient), CLSCTX_ALL, NULL, reinterpret_cast<void **>(&clientPointer)
+					  ))) {
+			client.reset(clientPointer);
+		}
+		if (client && FAILED(client->GetMixFormat(&format))) {
+			format = NULL;
+		}
+
+		if (format) {
+			// The shared mode mix format is 32 bit float on current Windows versions, 16 bit PCM is handled too
+			const WAVEFORMATEXTENSIBLE *extensible = reinterpret_cast<const WAVEFORMATEXTENSIBLE *>(format);
+			isFloat = format->wFormatTag == WAVE_FORMAT_IEEE_FLOAT ||
+					  (format->wFormatTag == WAVE_FORMAT_EXTENSIBLE &&
+					   extensible->SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT);
+			bool isPcm16 = !isFloat && format->wBitsPerSample == 16;
+
+			// 100 ms device buffer, in 100 ns units
+			if ((isFloat || isPcm16) &&
+				SUCCEEDED(client->Initialize(AUDCLNT_SHAREMODE_SHARED, AUDCLNT_STREAMFLAGS_LOOPBACK, 1000000, 0, format, NULL)
+				) &&
+				SUCCEEDED(client->GetService(__uuidof(IAudioCaptureClient), reinterpret_cast<void **>(&capturePointer)))) {
+				capture.reset(capturePointer);
+			}
+		}
+	}
+
+	if (!capture || FAILED(client->Start())) {
+		ready.set_value(0);
+		capture.reset();
+		client.reset();
+		device.reset();
+		enumerator.reset();
+		CoTaskMemFree(format);
+		if (SUCCEEDED(comResult))
+			CoUninitialize();
+		return;
+	}
+
+	ready.set_value(static_cast<int>(format->nSamplesPerSec));
+
+	while (!g_audioStop.load(std::memory_order_relaxed)) {
+		// Loopback streams can't be event driven on older Windows versions, poll every few milliseconds
+		Sleep(5);
+
+		UINT32 packetFrames = 0;
+		while (SUCCEEDED(capture->GetNextPacketSize(&packetFrames)) && packetFrames > 0) {
+			BYTE *data = NULL;
+			UINT32 frames = 0;
+			DWORD flags = 0;
+			if (FAILED(capture->GetBuffer(&data, &frames, &flags, NULL, NULL)))
+				break;
+
+			WriteLoopbackPacket(data, frames, format, isFloat, (flags & AUDCLNT_BUFFERFLAGS_SILENT) != 0);
+			capture->ReleaseBuffer(frames);
+		}
+	}
+
+	client->Stop();
+	capture.reset();
+	client.reset();
+	device.reset();
+	enumerator.reset();
+	CoTaskMemFree(format);
+	if (SUCCEEDED(comResult))
+		CoUninitialize();
+}
+#endif
+
+int InitRaylibDesktopAudioLoopback(const RaylibDesktopAudioConfig *config)
+{
+#ifdef _WIN32
+	if (IsAudioRunning())
+		return -1;
+
+	ApplyConfig(config);
+
+	// Sized for the highest common mix rate, the sample rate is only known once the device is open
+	g_audioRing.Reset(192000);
+	g_audioStop = false;
+
+	std::promise<int> ready;
+	std::future<int> sampleRate = ready.get_future();
+	g_captureThread = std::thread(LoopbackCaptureThreadProc, std::move(ready));
+
+	int rate = sampleRate.get();
+	if (rate == 0) {
+		g_captureThread.join();
+		return -1;
+	}
+
+	StartAnalysis(rate);
+	return 0;
+#else
+	(void)config;
+	return -1;
+#endif
+}
+
+void CleanupRaylibDesktopAudio(void)
+{
+	g_audioStop = true;
+
+	if (g_captureThread.joinable())
+		g_captureThread.join();
+	if (g_analysisThread.joinable())
+		g_analysisThread.join();
+
+	g_waveSamples.clear();
+	g_waveSamples.shrink_to_fit();
+}
+
+void RaylibDesktopSetAudioAnalysisPaused(bool paused)
+{
+	g_audioPaused.store(paused, std::memory_order_relaxed);
+}
+
+bool RaylibDesktopGetAudioSpectrum(RaylibDesktopAudioSpectrum *spectrum)
+{
+	bool isNew = g_spectrumBuffer.Acquire();
+	*spectrum = g_spectrumBuffer.buffers[g_spectrumBuffer.front];
+	return isNew;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// Audio analysis for music visualisers
+// A capture thread (system loopback on Windows, or a WAV file) feeds a lock-free ring buffer,
+// an analysis thread runs a windowed real FFT, aggregates it into smoothed bands
+// and publishes the result as a snapshot the render loop can read without locking.
+// Like RaylibDesktop.h this header doesn't include raylib.h.
+
+// Maximum number of bands in a spectrum
+#define RAYLIB_DESKTOP_MAX_AUDIO_BANDS 64
+
+typedef struct RaylibDesktopAudioConfig
+{
+	int fftSize; // Samples per analysis window, power of two between 64 and 16384
+	int bandCount; // Number of logarithmically spaced bands (1 - RAYLIB_DESKTOP_MAX_AUDIO_BANDS)
+	float minFrequency; // Lower edge of the first band in Hz
+	float maxFrequency; // Upper edge of the last band in Hz
+	float attack; // Smoothing factor for rising bands (0.0 - 1.0], 1.0 disables smoothing
+	float release; // Smoothing factor for falling bands (0.0 - 1.0], 1.0 disables smoothing
+} RaylibDesktopAudioConfig;
+
+typedef struct RaylibDesktopAudioSpectrum
+{
+	float bands[RAYLIB_DESKTOP_MAX_AUDIO_BANDS]; // Smoothed band levels (0.0 - 1.0)
+	int bandCount; // Number of valid entries in bands
+	float level; // Smoothed RMS level of the analysis window (0.0 - 1.0)
+	double captureTime; // RaylibDesktopGetAudioTime() when the newest analysed sample was captured
+	double publishTime; // RaylibDesktopGetAudioTime() when the snapshot was published
+	unsigned long long sequence; // Increments with every published snapshot, 0 before the first one
+} RaylibDesktopAudioSpectrum;
+
+// Returns the default configuration: 2048 sample FFT, 32 bands from 30 Hz to 16 kHz
+RaylibDesktopAudioConfig RaylibDesktopDefaultAudioConfig(void);
+
+// Call this function to start analysing the audio played by the default output device.
+// Pass NULL to use the default configuration.
+// Returns 0 on success, -1 if the device can't be captured, loopback isn't supported on this platform
+// or audio is already running (call CleanupRaylibDesktopAudio() first).
+int InitRaylibDesktopAudioLoopback(const RaylibDesktopAudioConfig *config);
+
+// Call this function to start analysing a WAV file (16 bit PCM or 32 bit float), played in real time and looped.
+// Useful as a stand-in for the loopback device, or for audio driven wallpapers with their own soundtrack.
+// Pass NULL to use the default configuration.
+// Returns 0 on success, -1 if the file can't be loaded or audio is already running.
+int InitRaylibDesktopAudioFromWave(const char *fileName, const RaylibDesktopAudioConfig *config);
+
+// Call this function to stop the capture and analysis threads.
+void CleanupRaylibDesktopAudio(void);
+
+// Pauses the analysis, e.g. while the wallpaper is occluded. Captured samples are dropped while paused.
+void RaylibDesktopSetAudioAnalysisPaused(bool paused);
+
+// Copies the latest spectrum into spectrum.
+// Returns true if a new snapshot was published since the last call.
+bool RaylibDesktopGetAudioSpectrum(RaylibDesktopAudioSpectrum *spectrum);
+
+// Returns the clock used for captureTime and publishTime, in seconds
+double RaylibDesktopGetAudioTime(void);
@@ -0,0 +1,147 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Internal to RaylibDesktopAudio.cpp, in a header so the tests and benchmarks can run the FFT directly.
+
+// SSE is always available on x64, and on x86 when the compiler targets it.
+// Define RAYLIB_DESKTOP_FFT_NO_SSE to build the scalar butterflies only.
+#if !defined(RAYLIB_DESKTOP_FFT_NO_SSE) &&                                                                             \
+	(defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define RAYLIB_DESKTOP_FFT_SSE
+#include <xmmintrin.h>
+#endif
+
+#define AUDIO_PI 3.14159265358979323846
+
+// Real FFT
+// An N point real FFT computed as an N/2 point complex FFT of the even/odd samples,
+// followed by a split step. The complex FFT is an iterative radix-2 FFT on separate real and
+// imaginary arrays, so each stage's butterflies can run four at a time with SSE.
+struct RealFft
+{
+	int size = 0; // N real samples
+	int half = 0; // N/2 complex points
+	std::vector<int> bitReverse; // half entries
+	std::vector<float> stageTwiddleRe; // half - 1 entries, the twiddles of the stage with span h start at h - 1
+	std::vector<float> stageTwiddleIm;
+	std::vector<float> splitTwiddleRe; // half entries, e^(-2*pi*i*k/N)
+	std::vector<float> splitTwiddleIm;
+	std::vector<float> window; // Hann window, size entries
+	float windowSum = 0.0f;
+	std::vector<float> re; // Work buffers, half entries
+	std::vector<float> im;
+
+	void Init(int fftSize)
+	{
+		size = fftSize;
+		half = fftSize / 2;
+
+		int bits = 0;
+		while ((1 << bits) < half)
+			bits++;
+
+		bitReverse.resize(half);
+		for (int i = 0; i < half; i++) {
+			int reversed = 0;
+			for (int b = 0; b < bits; b++) {
+				if (i & (1 << b))
+					reversed |= 1 << (bits - 1 - b);
+			}
+			bitReverse[i] = reversed;
+		}
+
+		stageTwiddleRe.assign(std::max(half - 1, 1), 0.0f);
+		stageTwiddleIm.assign(std::max(half - 1, 1), 0.0f);
+		for (int h = 1; h < half; h <<= 1) {
+			for (int j = 0; j < h; j++) {
+				double angle = -AUDIO_PI * j / h;
+				stageTwiddleRe[h - 1 + j] = static_cast<float>(std::cos(angle));
+				stageTwiddleIm[h - 1 + j] = static_cast<float>(std::sin(angle));
+			}
+		}
+
+		splitTwiddleRe.resize(half);
+		splitTwiddleIm.resize(half);
+		for (int k = 0; k < half; k++) {
+			double angle = -2.0 * AUDIO_PI * k / size;
+			splitTwiddleRe[k] = static_cast<float>(std::cos(angle));
+			splitTwiddleIm[k] = static_cast<float>(std::sin(angle));
+		}
+
+		window.resize(size);
+		windowSum = 0.0f;
+		for (int i = 0; i < size; i++) {
+			window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * AUDIO_PI * i / (size - 1)));
+			windowSum += window[i];
+		}
+
+		re.assign(half, 0.0f);
+		im.assign(half, 0.0f);
+	}
+
+	// Windows input (size samples) and writes the amplitude of bins 0 .. half - 1 into magnitudes
+	void Magnitudes(const float *input, float *magnitudes)
+	{
+		// Pack even samples as real and odd samples as imaginary parts, in bit reversed order
+		for (int k = 0; k < half; k++) {
+			int index = bitReverse[k];
+			re[index] = input[2 * k] * window[2 * k];
+			im[index] = input[2 * k + 1] * window[2 * k + 1];
+		}
+
+		for (int h = 1; h < half; h <<= 1) {
+			const float *twiddleRe = &stageTwiddleRe[h - 1];
+			const float *twiddleIm = &stageTwiddleIm[h - 1];
+
+			for (int k = 0; k < half; k += 2 * h) {
+				float *aRe = &re[k];
+				float *aIm = &im[k];
+				float *bRe = &re[k + h];
+				float *bIm = &im[k + h];
+
+				int j = 0;
+#ifdef RAYLIB_DESKTOP_FFT_SSE
+				for (; j + 4 <= h; j += 4) {
+					__m128 xRe = _mm_loadu_ps(bRe + j);
+					__m128 xIm = _mm_loadu_ps(bIm + j);
+					__m128 wRe = _mm_loadu_ps(twiddleRe + j);
+					__m128 wIm = _mm_loadu_ps(twiddleIm + j);
+					__m128 tRe = _mm_sub_ps(_mm_mul_ps(xRe, wRe), _mm_mul_ps(xIm, wIm));
+					__m128 tIm = _mm_add_ps(_mm_mul_ps(xRe, wIm), _mm_mul_ps(xIm, wRe));
+					__m128 yRe = _mm_loadu_ps(aRe + j);
+					__m128 yIm = _mm_loadu_ps(aIm + j);
+					_mm_storeu_ps(aRe + j, _mm_add_ps(yRe, tRe));
+					_mm_storeu_ps(aIm + j, _mm_add_ps(yIm, tIm));
+					_mm_storeu_ps(bRe + j, _mm_sub_ps(yRe, tRe));
+					_mm_storeu_ps(bIm + j, _mm_sub_ps(yIm, tIm));
+				}
+#endif
+				for (; j < h; j++) {
+					float tRe = bRe[j] * twiddleRe[j] - bIm[j] * twiddleIm[j];
+					float tIm = bRe[j] * twiddleIm[j] + bIm[j] * twiddleRe[j];
+					bRe[j] = aRe[j] - tRe;
+					bIm[j] = aIm[j] - tIm;
+					aRe[j] += tRe;
+					aIm[j] += tIm;
+				}
+			}
+		}
+
+		// Split the packed spectrum Z into the spectrum X of the real input:
+		// X[k] = (Z[k] + conj(Z[N/2 - k])) / 2 - i * e^(-2*pi*i*k/N) * (Z[k] - conj(Z[N/2 - k])) / 2
+		float scale = 2.0f / windowSum;
+		for (int k = 0; k < half; k++) {
+			int mirror = (half - k) & (half - 1);
+			float evenRe = 0.5f * (re[k] + re[mirror]);
+			float evenIm = 0.5f * (im[k] - im[mirror]);
+			float oddRe = 0.5f * (im[k] + im[mirror]);
+			float oddIm = -0.5f * (re[k] - re[mirror]);
+
+			float xRe = evenRe + oddRe * splitTwiddleRe[k] - oddIm * splitTwiddleIm[k];
+			float xIm = evenIm + oddRe * splitTwiddleIm[k] + oddIm * splitTwiddleRe[k];
+			magnitudes[k] = std::sqrt(xRe * xRe + xIm * xIm) * scale;
+		}
+	}
+};
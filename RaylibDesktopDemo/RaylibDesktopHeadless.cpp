@@ -0,0 +1,345 @@
+#include "RaylibDesktopHeadless.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Maximum number of scripted monitors
+#define HEADLESS_MAX_MONITORS RAYLIB_DESKTOP_MAX_MONITORS
+// Number of mouse buttons, same as the desktop implementation
+#define HEADLESS_MOUSE_BUTTON_COUNT 5
+
+enum HeadlessCommand
+{
+	HEADLESS_MOUSE,
+	HEADLESS_PRESS,
+	HEADLESS_RELEASE,
+	HEADLESS_OCCLUSION,
+	HEADLESS_LOCK,
+	HEADLESS_POWER,
+	HEADLESS_SAVER,
+	HEADLESS_BUSY,
+	HEADLESS_IDLE
+};
+
+struct HeadlessEvent
+{
+	int frame;
+	HeadlessCommand command;
+	int x; // Cursor x, button index, lock, saver or busy state, 1 on battery
+	int y; // Cursor y or battery percent
+	double fraction; // Occlusion fraction or idle seconds
+	int monitor; // Occluded monitor, -1 for all monitors
+	int line; // Line in the timeline file, for the checks after parsing
+};
+
+static bool g_headless = false;
+static int g_headlessFrame = 0;
+
+static MonitorInfo g_headlessMonitors[HEADLESS_MAX_MONITORS];
+static double g_headlessOcclusion[HEADLESS_MAX_MONITORS];
+static int g_headlessMonitorCount = 0;
+
+// Timeline, sorted by frame, and the next event to apply
+static std::vector<HeadlessEvent> g_headlessEvents;
+static size_t g_headlessNextEvent = 0;
+
+static bool g_headlessButtons[HEADLESS_MOUSE_BUTTON_COUNT] = {false, false, false, false, false};
+static int g_headlessCursorX = 0;
+static int g_headlessCursorY = 0;
+static bool g_headlessLocked = false;
+
+// Quality policy inputs, a headless desktop starts plugged in, busy free and active
+static bool g_headlessOnBattery = false;
+static int g_headlessBatteryPercent = -1;
+static bool g_headlessBatterySaver = false;
+static bool g_headlessUserBusy = false;
+static double g_headlessIdleSeconds = 0.0;
+
+// Parses one timeline line, returns false for malformed lines
+static bool ParseTimelineLine(const char *line, HeadlessEvent *event, MonitorInfo *monitor, bool *isMonitor)
+{
+	char command[32];
+	int consumed = 0;
+	if (sscanf(line, "%d %31s %n", &event->frame, command, &consumed) < 2)
+		return false;
+
+	const char *arguments = line + consumed;
+	*isMonitor = false;
+	event->x = 0;
+	event->y = 0;
+	event->fraction = 0.0;
+	event->monitor = -1;
+
+	if (strcmp(command, "monitor") == 0) {
+		*isMonitor = true;
+		return sscanf(
+				   arguments,
+				   "%d %d %d %d",
+				   &monitor->monitorLeftCoordinate,
+				   &monitor->monitorTopCoordinate,
+				   &monitor->monitorWidth,
+				   &monitor->monitorHeight
+			   ) == 4;
+	}
+	if (strcmp(command, "mouse") == 0) {
+		event->command = HEADLESS_MOUSE;
+		return sscanf(arguments, "%d %d", &event->x, &event->y) == 2;
+	}
+	if (strcmp(command, "press") == 0 || strcmp(command, "release") == 0) {
+		event->command = command[0] == 'p' ? HEADLESS_PRESS : HEADLESS_RELEASE;
+		return sscanf(arguments, "%d", &event->x) == 1 && event->x >= 0 && event->x < HEADLESS_MOUSE_BUTTON_COUNT;
+	}
+	if (strcmp(command, "occlusion") == 0) {
+		event->command = HEADLESS_OCCLUSION;
+		int count = sscanf(arguments, "%lf %d", &event->fraction, &event->monitor);
+		return count == 1 || (count == 2 && event->monitor >= 0);
+	}
+	if (strcmp(command, "lock") == 0) {
+		event->command = HEADLESS_LOCK;
+		return sscanf(arguments, "%d", &event->x) == 1;
+	}
+	if (strcmp(command, "power") == 0) {
+		char source[16];
+		event->command = HEADLESS_POWER;
+		event->y = -1;
+		if (sscanf(arguments, "%15s %d", source, &event->y) < 1)
+			return false;
+		event->x = strcmp(source, "battery") == 0;
+		return (event->x || strcmp(source, "ac") == 0) && event->y >= -1 && event->y <= 100;
+	}
+	if (strcmp(command, "saver") == 0 || strcmp(command, "busy") == 0) {
+		event->command = command[0] == 's' ? HEADLESS_SAVER : HEADLESS_BUSY;
+		return sscanf(arguments, "%d", &event->x) == 1;
+	}
+	if (strcmp(command, "idle") == 0) {
+		event->command = HEADLESS_IDLE;
+		return sscanf(arguments, "%lf", &event->fraction) == 1 && event->fraction >= 0.0;
+	}
+	return false;
+}
+
+static int LoadTimeline(const char *fileName)
+{
+	FILE *file = fopen(fileName, "r");
+	if (!file)
+		return -1;
+
+	char line[256];
+	int lineNumber = 0;
+	while (fgets(line, sizeof(line), file)) {
+		lineNumber++;
+
+		const char *start = line;
+		while (*start == ' ' || *start == '\t')
+			start++;
+		if (*start == '#' || *start == '\n' || *start == '\r' || *start == '\0')
+			continue;
+
+		HeadlessEvent event;
+		MonitorInfo monitor;
+		bool isMonitor;
+		if (!ParseTimelineLine(start, &event, &monitor, &isMonitor)) {
+			fprintf(stderr, "%s:%d: invalid timeline event\n", fileName, lineNumber);
+			fclose(file);
+			return -1;
+		}
+
+		if (isMonitor) {
+			if (event.frame != 0 || g_headlessMonitorCount >= HEADLESS_MAX_MONITORS) {
+				fprintf(stderr, "%s:%d: monitors must be declared at frame 0\n", fileName, lineNumber);
+				fclose(file);
+				return -1;
+			}
+			if (monitor.monitorWidth <= 0 || monitor.monitorHeight <= 0) {
+				fprintf(stderr, "%s:%d: monitor width and height must be positive\n", fileName, lineNumber);
+				fclose(file);
+				return -1;
+			}
+			g_headlessMonitors[g_headlessMonitorCount++] = monitor;
+		}
+		else {
+			event.line = lineNumber;
+			g_headlessEvents.push_back(event);
+		}
+	}
+
+	fclose(file);
+
+	// Monitors can be declared anywhere in the file, without any there is the single default monitor
+	int monitorCount = g_headlessMonitorCount > 0 ? g_headlessMonitorCount : 1;
+	for (const HeadlessEvent &event : g_headlessEvents) {
+		if (event.command == HEADLESS_OCCLUSION && event.monitor >= monitorCount) {
+			fprintf(
+				stderr,
+				"%s:%d: monitor %d doesn't exist (%d monitors)\n",
+				fileName,
+				event.line,
+				event.monitor,
+				monitorCount
+			);
+			return -1;
+		}
+	}
+
+	// Events of the same frame keep their file order
+	std::stable_sort(
+		g_headlessEvents.begin(),
+		g_headlessEvents.end(),
+		[](const HeadlessEvent &a, const HeadlessEvent &b) { return a.frame < b.frame; }
+	);
+	return 0;
+}
+
+int InitRaylibDesktopHeadless(int width, int height, const char *timelineFileName)
+{
+	g_headless = true;
+	g_headlessFrame = 0;
+	g_headlessMonitorCount = 0;
+	g_headlessEvents.clear();
+	g_headlessNextEvent = 0;
+	g_headlessCursorX = 0;
+	g_headlessCursorY = 0;
+	g_headlessLocked = false;
+	g_headlessOnBattery = false;
+	g_headlessBatteryPercent = -1;
+	g_headlessBatterySaver = false;
+	g_headlessUserBusy = false;
+	g_headlessIdleSeconds = 0.0;
+	for (int i = 0; i < HEADLESS_MOUSE_BUTTON_COUNT; i++) {
+		g_headlessButtons[i] = false;
+	}
+
+	if (timelineFileName && LoadTimeline(timelineFileName) != 0)
+		return -1;
+
+	// Without a layout, the desktop is a single monitor of the requested size
+	if (g_headlessMonitorCount == 0) {
+		g_headlessMonitors[0] = {0, 0, width, height};
+		g_headlessMonitorCount = 1;
+	}
+
+	for (int i = 0; i < HEADLESS_MAX_MONITORS; i++) {
+		g_headlessOcclusion[i] = 0.0;
+	}
+	return 0;
+}
+
+bool RaylibDesktopIsHeadless(void)
+{
+	return g_headless;
+}
+
+int RaylibDesktopHeadlessGetFrame(void)
+{
+	return g_headlessFrame;
+}
+
+void RaylibDesktopHeadlessAdvanceFrame(void)
+{
+	while (g_headlessNextEvent < g_headlessEvents.size() &&
+		   g_headlessEvents[g_headlessNextEvent].frame <= g_headlessFrame) {
+		const HeadlessEvent &event = g_headlessEvents[g_headlessNextEvent++];
+
+		switch (event.command) {
+		case HEADLESS_MOUSE:
+			g_headlessCursorX = event.x;
+			g_headlessCursorY = event.y;
+			break;
+		case HEADLESS_PRESS:
+			g_headlessButtons[event.x] = true;
+			break;
+		case HEADLESS_RELEASE:
+			g_headlessButtons[event.x] = false;
+			break;
+		case HEADLESS_OCCLUSION:
+			for (int i = 0; i < g_headlessMonitorCount; i++) {
+				if (event.monitor < 0 || event.monitor == i) {
+					g_headlessOcclusion[i] = event.fraction;
+				}
+			}
+			break;
+		case HEADLESS_LOCK:
+			g_headlessLocked = event.x != 0;
+			break;
+		case HEADLESS_POWER:
+			g_headlessOnBattery = event.x != 0;
+			g_headlessBatteryPercent = event.y;
+			break;
+		case HEADLESS_SAVER:
+			g_headlessBatterySaver = event.x != 0;
+			break;
+		case HEADLESS_BUSY:
+			g_headlessUserBusy = event.x != 0;
+			break;
+		case HEADLESS_IDLE:
+			g_headlessIdleSeconds = event.fraction;
+			break;
+		}
+	}
+
+	g_headlessFrame++;
+}
+
+int RaylibDesktopHeadlessGetMonitors(MonitorInfo *monitors, int capacity)
+{
+	int count = std::min(g_headlessMonitorCount, capacity);
+	for (int i = 0; i < count; i++) {
+		monitors[i] = g_headlessMonitors[i];
+	}
+	return count;
+}
+
+MonitorInfo RaylibDesktopHeadlessGetDesktop(void)
+{
+	// Bounding box of all monitors, which start at (0,0) in desktop coordinates
+	MonitorInfo desktop = {0, 0, 0, 0};
+	for (int i = 0; i < g_headlessMonitorCount; i++) {
+		const MonitorInfo &monitor = g_headlessMonitors[i];
+		desktop.monitorWidth = std::max(desktop.monitorWidth, monitor.monitorLeftCoordinate + monitor.monitorWidth);
+		desktop.monitorHeight = std::max(desktop.monitorHeight, monitor.monitorTopCoordinate + monitor.monitorHeight);
+	}
+	return desktop;
+}
+
+int RaylibDesktopHeadlessGetWindows(MonitorInfo *windows, int capacity)
+{
+	// One window per occluded monitor, covering the left part of it
+	int count = 0;
+	for (int i = 0; i < g_headlessMonitorCount && count < capacity; i++) {
+		if (g_headlessOcclusion[i] <= 0.0)
+			continue;
+		MonitorInfo window = g_headlessMonitors[i];
+		window.monitorWidth = static_cast<int>(window.monitorWidth * std::min(g_headlessOcclusion[i], 1.0) + 0.5);
+		windows[count++] = window;
+	}
+	return count;
+}
+
+bool RaylibDesktopHeadlessIsDesktopLocked(void)
+{
+	return g_headlessLocked;
+}
+
+bool RaylibDesktopHeadlessIsMouseButtonDown(int button)
+{
+	if (button < 0 || button >= HEADLESS_MOUSE_BUTTON_COUNT)
+		return false;
+	return g_headlessButtons[button];
+}
+
+void RaylibDesktopHeadlessGetCursorPos(int *x, int *y)
+{
+	*x = g_headlessCursorX;
+	*y = g_headlessCursorY;
+}
+
+void RaylibDesktopHeadlessGetPolicyInputs(RaylibDesktopPolicyInputs *inputs)
+{
+	inputs->onBattery = g_headlessOnBattery;
+	inputs->batterySaver = g_headlessBatterySaver;
+	inputs->batteryPercent = g_headlessBatteryPercent;
+	inputs->userBusy = g_headlessUserBusy;
+	inputs->inputIdleSeconds = g_headlessIdleSeconds;
+}
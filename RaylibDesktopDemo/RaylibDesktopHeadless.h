@@ -0,0 +1,53 @@
+#pragma once
+#include <stddef.h>
+
+#include "RaylibDesktop.h"
+
+// Headless mode
+// Replaces the desktop with a scripted one, so complete wallpaper scenes can run without
+// being attached to a Windows desktop (or on other platforms, e.g. for benchmarks).
+// While headless, the replacement APIs in RaylibDesktop.h (monitors, occlusion, lock state, mouse,
+// quality policy inputs) return the values of the timeline instead of querying the system.
+//
+// Timeline files contain one event per line: <frame> <command> <arguments>
+//   0 monitor <x> <y> <width> <height>  Adds a monitor (frame 0 only), defaults to one monitor of the given size
+//   <frame> mouse <x> <y>               Moves the cursor, in desktop coordinates
+//   <frame> press <button>              Presses a mouse button (0 - 4)
+//   <frame> release <button>            Releases a mouse button
+//   <frame> occlusion <fraction> [monitor] Covers the left <fraction> of one monitor's width with a window
+//                                       (default: all monitors), measured like a desktop window
+//   <frame> lock <0|1>                  Locks or unlocks the desktop
+//   <frame> power <ac|battery> [percent] Switches the power source, the battery charge defaults to unknown
+//   <frame> saver <0|1>                 Turns the battery saver off or on
+//   <frame> busy <0|1>                  Ends or starts a fullscreen app or presentation
+//   <frame> idle <seconds>              Sets the time since the last input, held until the next idle event
+// Empty lines and lines starting with # are ignored.
+// Monitors need a positive size, occlusion events an index of a monitor declared anywhere in the file
+// (only 0 without monitor lines). Invalid lines are reported as <file>:<line> and fail the load.
+// The frame advances every time RaylibDesktopUpdateMouseState() is called.
+
+// Call this function instead of InitRaylibDesktop() to run headless.
+// Pass NULL as timelineFileName to run without any scripted events.
+// Returns 0 on success, -1 if the timeline can't be loaded.
+int InitRaylibDesktopHeadless(int width, int height, const char *timelineFileName);
+
+// Returns true after InitRaylibDesktopHeadless()
+bool RaylibDesktopIsHeadless(void);
+
+// Returns the number of frames advanced so far
+int RaylibDesktopHeadlessGetFrame(void);
+
+// Scripted state used by the replacement APIs while headless
+void RaylibDesktopHeadlessAdvanceFrame(void);
+int RaylibDesktopHeadlessGetMonitors(MonitorInfo *monitors, int capacity);
+MonitorInfo RaylibDesktopHeadlessGetDesktop(void);
+// Returns the scripted windows covering the monitors, in desktop coordinates
+int RaylibDesktopHeadlessGetWindows(MonitorInfo *windows, int capacity);
+bool RaylibDesktopHeadlessIsDesktopLocked(void);
+bool RaylibDesktopHeadlessIsMouseButtonDown(int button);
+void RaylibDesktopHeadlessGetCursorPos(int *x, int *y);
+// Fills every input except occlusionFraction
+void RaylibDesktopHeadlessGetPolicyInputs(RaylibDesktopPolicyInputs *inputs);
+
+// Returns the CPU time (user + kernel) used by the process and its peak memory usage, for benchmark reports
+void RaylibDesktopGetProcessStats(double *cpuSeconds, size_t *peakMemoryBytes);
@@ -0,0 +1,295 @@
+#include "RaylibDesktopHostInternal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Updates scheduled less than this early still run, so a 30 FPS scene in a 60 FPS host doesn't skip
+// an update whenever a frame is slightly short.
+#define SCHEDULE_TOLERANCE_SECONDS 0.002
+
+static RaylibDesktopHostConfig g_hostConfig;
+MonitorInfo g_hostWindow;
+
+HostScene g_hostScenes[RAYLIB_DESKTOP_MAX_SCENES];
+int g_hostSceneCount = 0;
+
+// Scene rectangles in a contiguous array for GetMonitorOcclusionFractions()
+static MonitorInfo g_hostMonitors[RAYLIB_DESKTOP_MAX_SCENES];
+static double g_hostOcclusion[RAYLIB_DESKTOP_MAX_SCENES];
+
+static RaylibDesktopPolicyInputs g_hostPolicyInputs;
+static double g_nextPolicyUpdate = 0.0;
+
+// Update pool
+// The main thread publishes the indices of the due scenes and bumps g_hostGeneration,
+// then every thread (main included) claims scenes through g_hostNextJob until none are left.
+// The job list is only written while no pool thread is running jobs (g_hostActiveWorkers == 0),
+// so a thread waking up late never sees a half written list.
+static std::mutex g_hostMutex;
+static std::condition_variable g_hostWake;
+static std::condition_variable g_hostDone;
+static std::vector<std::thread> g_hostWorkers;
+static bool g_hostStop = false;
+static unsigned int g_hostGeneration = 0;
+static int g_hostActiveWorkers = 0;
+
+static int g_hostJobs[RAYLIB_DESKTOP_MAX_SCENES];
+static int g_hostJobCount = 0;
+static std::atomic<int> g_hostNextJob(0);
+static std::atomic<int> g_hostRemainingJobs(0);
+
+int g_hostRenderJobs[RAYLIB_DESKTOP_MAX_SCENES];
+int g_hostRenderJobCount = 0;
+void (*g_hostUnloadTargets)(void) = NULL;
+
+static void RunHostJobs()
+{
+	int job;
+	while ((job = g_hostNextJob.fetch_add(1)) < g_hostJobCount) {
+		HostScene &hostScene = g_hostScenes[g_hostJobs[job]];
+		if (hostScene.scene.update)
+			hostScene.scene.update(hostScene.scene.userData, &hostScene.context);
+
+		if (g_hostRemainingJobs.fetch_sub(1) == 1) {
+			std::lock_guard<std::mutex> lock(g_hostMutex);
+			g_hostDone.notify_all();
+		}
+	}
+}
+
+static void HostWorkerProc()
+{
+	std::unique_lock<std::mutex> lock(g_hostMutex);
+	unsigned int generation = g_hostGeneration;
+	for (;;) {
+		g_hostWake.wait(lock, [&] { return g_hostStop || g_hostGeneration != generation; });
+		if (g_hostStop)
+			return;
+
+		generation = g_hostGeneration;
+		g_hostActiveWorkers++;
+		lock.unlock();
+
+		RunHostJobs();
+
+		lock.lock();
+		g_hostActiveWorkers--;
+		g_hostDone.notify_all();
+	}
+}
+
+// Runs the updates of the given scenes and waits for all of them
+static void DispatchHostJobs(const int *jobs, int jobCount)
+{
+	if (jobCount == 0)
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(g_hostMutex);
+		g_hostDone.wait(lock, [] { return g_hostActiveWorkers == 0; });
+
+		std::copy(jobs, jobs + jobCount, g_hostJobs);
+		g_hostJobCount = jobCount;
+		g_hostNextJob = 0;
+		g_hostRemainingJobs = jobCount;
+		g_hostGeneration++;
+	}
+
+	// A single job isn't worth waking the pool for
+	if (jobCount > 1)
+		g_hostWake.notify_all();
+
+	RunHostJobs();
+
+	std::unique_lock<std::mutex> lock(g_hostMutex);
+	g_hostDone.wait(lock, [] { return g_hostRemainingJobs == 0; });
+}
+
+RaylibDesktopHostConfig RaylibDesktopDefaultHostConfig(void)
+{
+	RaylibDesktopHostConfig config;
+	config.updateThreadCount = -1;
+	config.occlusionThreshold = 0.95;
+	config.policyIntervalSeconds = 1.0;
+	config.policy = RaylibDesktopDefaultQualityPolicy();
+	return config;
+}
+
+void InitRaylibDesktopHost(const MonitorInfo &window, const RaylibDesktopHostConfig *config)
+{
+	g_hostConfig = config ? *config : RaylibDesktopDefaultHostConfig();
+	g_hostWindow = window;
+	g_hostSceneCount = 0;
+	g_nextPolicyUpdate = 0.0;
+	g_hostStop = false;
+
+	int threadCount = g_hostConfig.updateThreadCount;
+	if (threadCount < 0) {
+		// The main thread takes part in the updates, leave a core for the rest of the desktop
+		int cpuCount = static_cast<int>(std::thread::hardware_concurrency());
+		threadCount = std::max(0, cpuCount - 2);
+	}
+	threadCount = std::min(threadCount, RAYLIB_DESKTOP_MAX_SCENES - 1);
+
+	for (int i = 0; i < threadCount; i++) {
+		g_hostWorkers.emplace_back(HostWorkerProc);
+	}
+}
+
+int RaylibDesktopHostAddScene(const MonitorInfo &monitor, const RaylibDesktopScene &scene)
+{
+	if (g_hostSceneCount >= RAYLIB_DESKTOP_MAX_SCENES)
+		return -1;
+
+	int sceneIndex = g_hostSceneCount++;
+	HostScene &hostScene = g_hostScenes[sceneIndex];
+	hostScene = {};
+	hostScene.scene = scene;
+	hostScene.policyState = {-1, -1, 0.0};
+	hostScene.lastUpdate = -1.0;
+	hostScene.context.sceneIndex = sceneIndex;
+	hostScene.context.monitor = monitor;
+	hostScene.context.tier = RaylibDesktopGetQualityTier(g_hostConfig.policy, hostScene.policyState);
+
+	g_hostMonitors[sceneIndex] = monitor;
+	return sceneIndex;
+}
+
+int RaylibDesktopHostUpdate(double time)
+{
+	if (g_hostSceneCount == 0)
+		return 0;
+
+	// Shared services, sampled once for all scenes
+	bool locked = IsDesktopLocked();
+	if (!locked)
+		GetMonitorOcclusionFractions(g_hostMonitors, g_hostSceneCount, g_hostOcclusion);
+
+	int mouseX = RaylibDesktopGetMouseX() + g_hostWindow.monitorLeftCoordinate;
+	int mouseY = RaylibDesktopGetMouseY() + g_hostWindow.monitorTopCoordinate;
+
+	// The power and idle inputs change slowly and are expensive to query
+	bool policyDue = !locked && time >= g_nextPolicyUpdate;
+	if (policyDue) {
+		g_nextPolicyUpdate = time + g_hostConfig.policyIntervalSeconds;
+		RaylibDesktopQueryPolicyInputs(g_hostWindow, &g_hostPolicyInputs);
+	}
+
+	int jobs[RAYLIB_DESKTOP_MAX_SCENES];
+	int jobCount = 0;
+
+	for (int i = 0; i < g_hostSceneCount; i++) {
+		HostScene &hostScene = g_hostScenes[i];
+		RaylibDesktopSceneContext &context = hostScene.context;
+
+		if (!locked) {
+			context.occlusionFraction = g_hostOcclusion[i];
+
+			// Culled scenes keep their tier, so they don't come back at a lower quality once visible again
+			if (policyDue && g_hostOcclusion[i] < g_hostConfig.occlusionThreshold) {
+				// Same power and idle state for every scene, but each one is judged by its own monitor's occlusion
+				RaylibDesktopPolicyInputs inputs = g_hostPolicyInputs;
+				inputs.occlusionFraction = g_hostOcclusion[i];
+				RaylibDesktopUpdateQualityTier(g_hostConfig.policy, hostScene.policyState, inputs, time);
+				context.tier = RaylibDesktopGetQualityTier(g_hostConfig.policy, hostScene.policyState);
+			}
+		}
+
+		bool visible =
+			!locked && context.occlusionFraction < g_hostConfig.occlusionThreshold && context.tier.targetFps > 0;
+
+		hostScene.stats.visible = visible;
+		hostScene.stats.currentTier = hostScene.policyState.currentTier < 0 ? 0 : hostScene.policyState.currentTier;
+
+		if (!visible) {
+			// Start over with an immediate update once the monitor is visible again
+			hostScene.stats.culledFrames++;
+			hostScene.lastUpdate = -1.0;
+			hostScene.hasFrame = false;
+			continue;
+		}
+
+		if (hostScene.lastUpdate >= 0.0 && time + SCHEDULE_TOLERANCE_SECONDS < hostScene.nextUpdate)
+			continue;
+
+		// Keep a steady cadence, but don't try to catch up after a long frame
+		double period = 1.0 / context.tier.targetFps;
+		hostScene.nextUpdate = hostScene.lastUpdate >= 0.0 ? hostScene.nextUpdate + period : time + period;
+		if (hostScene.nextUpdate < time)
+			hostScene.nextUpdate = time + period;
+
+		context.deltaTime = hostScene.lastUpdate >= 0.0 ? (float)(time - hostScene.lastUpdate) : 0.0f;
+		context.time = time;
+		context.mouseX = mouseX - context.monitor.monitorLeftCoordinate;
+		context.mouseY = mouseY - context.monitor.monitorTopCoordinate;
+		context.mouseInside = context.mouseX >= 0 && context.mouseX < context.monitor.monitorWidth &&
+							  context.mouseY >= 0 && context.mouseY < context.monitor.monitorHeight;
+
+		hostScene.lastUpdate = time;
+		hostScene.stats.updates++;
+		jobs[jobCount++] = i;
+	}
+
+	DispatchHostJobs(jobs, jobCount);
+
+	std::copy(jobs, jobs + jobCount, g_hostRenderJobs);
+	g_hostRenderJobCount = jobCount;
+	return jobCount;
+}
+
+int RaylibDesktopHostGetTargetFps(void)
+{
+	int targetFps = 0;
+	for (int i = 0; i < g_hostSceneCount; i++) {
+		const HostScene &hostScene = g_hostScenes[i];
+		if (hostScene.stats.visible && hostScene.context.tier.targetFps > targetFps)
+			targetFps = hostScene.context.tier.targetFps;
+	}
+	return targetFps;
+}
+
+int RaylibDesktopHostGetSceneCount(void)
+{
+	return g_hostSceneCount;
+}
+
+bool RaylibDesktopHostGetSceneStats(int sceneIndex, RaylibDesktopSceneStats *stats)
+{
+	if (sceneIndex < 0 || sceneIndex >= g_hostSceneCount)
+		return false;
+
+	*stats = g_hostScenes[sceneIndex].stats;
+	return true;
+}
+
+void CleanupRaylibDesktopHost(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(g_hostMutex);
+		g_hostStop = true;
+	}
+	g_hostWake.notify_all();
+
+	for (std::thread &worker : g_hostWorkers) {
+		worker.join();
+	}
+	g_hostWorkers.clear();
+
+	for (int i = 0; i < g_hostSceneCount; i++) {
+		HostScene &hostScene = g_hostScenes[i];
+		if (hostScene.scene.unload)
+			hostScene.scene.unload(hostScene.scene.userData);
+		hostScene = {};
+	}
+	if (g_hostUnloadTargets) {
+		g_hostUnloadTargets();
+		g_hostUnloadTargets = NULL;
+	}
+	g_hostSceneCount = 0;
+	g_hostJobCount = 0;
+	g_hostRenderJobCount = 0;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "RaylibDesktop.h"
+
+// Multi-wallpaper host
+// Runs several independent scenes in one process, each bound to a monitor rectangle inside the
+// wallpaper window spanning the desktop. The scenes share one GL context and one set of desktop
+// services: mouse, lock state and occlusion are sampled once per frame and fanned out to every scene.
+// Each scene is culled and scheduled by its own monitor: occluded scenes are skipped, partially occluded
+// ones drop to a lower quality tier, and the updates of the scenes due in a frame run on a thread pool.
+// Like RaylibDesktop.h this header doesn't include raylib.h.
+// Only RaylibDesktopHostRender() and RaylibDesktopHostDraw() use raylib (RaylibDesktopHostRender.cpp). Without them,
+// e.g. in tests, RaylibDesktopHost.cpp schedules and updates the scenes without a GL context.
+
+// Maximum number of scenes a host can run
+#define RAYLIB_DESKTOP_MAX_SCENES 16
+
+// State passed to the scene callbacks
+typedef struct RaylibDesktopSceneContext
+{
+	int sceneIndex; // Index returned by RaylibDesktopHostAddScene()
+	MonitorInfo monitor; // Scene rectangle in desktop coordinates
+	float deltaTime; // Seconds since the scene's previous update, 0 on the first update
+	double time; // Host time of this update
+	int mouseX; // Cursor relative to the scene's top-left corner
+	int mouseY;
+	bool mouseInside; // True if the cursor is inside the scene's rectangle
+	double occlusionFraction; // Fraction of the scene's monitor covered by other windows
+	RaylibDesktopQualityTier tier; // Quality tier of the scene, selected from its own monitor's occlusion
+} RaylibDesktopSceneContext;
+
+// Scene callbacks, userData is passed through unchanged.
+typedef struct RaylibDesktopScene
+{
+	void *userData;
+	// Called on a pool thread when the scene is due, must not call raylib or touch other scenes.
+	void (*update)(void *userData, const RaylibDesktopSceneContext *context);
+	// Called on the main thread after an update, inside the scene's render target.
+	// Draw in monitor coordinates (0, 0 is the scene's top-left corner), the host applies the tier's resolution scale.
+	void (*draw)(void *userData, const RaylibDesktopSceneContext *context);
+	// Called on the main thread by CleanupRaylibDesktopHost(), may be NULL.
+	void (*unload)(void *userData);
+} RaylibDesktopScene;
+
+typedef struct RaylibDesktopHostConfig
+{
+	int updateThreadCount; // Pool threads besides the main thread, -1 picks a count based on the CPU count
+	double occlusionThreshold; // Occlusion fraction at or above which a scene is culled
+	double policyIntervalSeconds; // Interval at which the power and idle inputs of the quality policy are queried
+	RaylibDesktopQualityPolicy policy; // Policy each scene's tier is selected with
+} RaylibDesktopHostConfig;
+
+typedef struct RaylibDesktopSceneStats
+{
+	int currentTier; // Index of the scene's tier in the policy
+	bool visible; // False while the scene is culled
+	int updates; // Total number of updates (and renders)
+	int culledFrames; // Total number of frames the scene was culled
+} RaylibDesktopSceneStats;
+
+// Returns the default configuration: CPU count based pool, 0.95 occlusion threshold,
+// 1 second policy interval and the default quality policy
+RaylibDesktopHostConfig RaylibDesktopDefaultHostConfig(void);
+
+// Call this function after the wallpaper window is created, window is the target passed to
+// ConfigureDesktopPositioning(). Pass NULL to use the default configuration.
+void InitRaylibDesktopHost(const MonitorInfo &window, const RaylibDesktopHostConfig *config);
+
+// Adds a scene bound to a monitor rectangle (desktop coordinates, e.g. from RaylibDesktopGetMonitors()).
+// Returns the scene index, or -1 if RAYLIB_DESKTOP_MAX_SCENES scenes are already running.
+int RaylibDesktopHostAddScene(const MonitorInfo &monitor, const RaylibDesktopScene &scene);
+
+// Call this function once per frame after RaylibDesktopUpdateMouseState(), with the current time in seconds.
+// Samples the shared services, culls and schedules the scenes and runs the due updates on the pool.
+// Returns the number of scenes updated this frame.
+int RaylibDesktopHostUpdate(double time);
+
+// Call this function after RaylibDesktopHostUpdate() and outside BeginDrawing().
+// Draws the scenes updated this frame into their render targets.
+void RaylibDesktopHostRender(void);
+
+// Call this function between BeginDrawing() and EndDrawing().
+// Composites the visible scenes into the wallpaper window, culled scenes are left untouched.
+void RaylibDesktopHostDraw(void);
+
+// Returns the highest target FPS of the visible scenes, 0 if every scene is culled
+int RaylibDesktopHostGetTargetFps(void);
+
+// Returns the number of scenes added
+int RaylibDesktopHostGetSceneCount(void);
+
+// Copies the scheduling statistics of a scene into stats.
+// Returns false if sceneIndex is out of range.
+bool RaylibDesktopHostGetSceneStats(int sceneIndex, RaylibDesktopSceneStats *stats);
+
+// Call this function to stop the pool, unload the scenes and their render targets.
+// Must be called on the main thread before CloseWindow().
+void CleanupRaylibDesktopHost(void);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "RaylibDesktopHost.h"
+
+// Internal to the host: the scheduling in RaylibDesktopHost.cpp doesn't depend on raylib, the render
+// targets live in RaylibDesktopHostRender.cpp. The tests link the scheduling alone, without a GL context.
+
+struct HostScene
+{
+	RaylibDesktopScene scene;
+	RaylibDesktopSceneContext context; // Written by the main thread before dispatch, read by the scene's callbacks
+	RaylibDesktopPolicyState policyState;
+	RaylibDesktopSceneStats stats;
+
+	double lastUpdate; // Host time of the previous update, -1 forces an update on the next visible frame
+	double nextUpdate; // Host time at which the scene is due again
+
+	bool hasFrame; // The scene's render target holds a frame of the current visible period
+};
+
+extern MonitorInfo g_hostWindow;
+extern HostScene g_hostScenes[RAYLIB_DESKTOP_MAX_SCENES];
+extern int g_hostSceneCount;
+
+// Scenes updated this frame, rendered by RaylibDesktopHostRender() on the main thread
+extern int g_hostRenderJobs[RAYLIB_DESKTOP_MAX_SCENES];
+extern int g_hostRenderJobCount;
+
+// Set by RaylibDesktopHostRender() once it created render targets, called by CleanupRaylibDesktopHost()
+extern void (*g_hostUnloadTargets)(void);
@@ -0,0 +1,79 @@
+#include "RaylibDesktopHostInternal.h"
+
+#include <algorithm>
+
+#include "raylib.h"
+
+// Render targets of the host, the only part of it using raylib
+
+// Last rendered frame of each scene, sized by the tier's resolution scale
+static RenderTexture2D g_hostTargets[RAYLIB_DESKTOP_MAX_SCENES];
+
+static void UnloadHostTargets(void)
+{
+	for (int i = 0; i < RAYLIB_DESKTOP_MAX_SCENES; i++) {
+		if (g_hostTargets[i].id != 0)
+			UnloadRenderTexture(g_hostTargets[i]);
+		g_hostTargets[i] = {0};
+	}
+}
+
+void RaylibDesktopHostRender(void)
+{
+	g_hostUnloadTargets = UnloadHostTargets;
+
+	for (int job = 0; job < g_hostRenderJobCount; job++) {
+		int sceneIndex = g_hostRenderJobs[job];
+		HostScene &hostScene = g_hostScenes[sceneIndex];
+		RenderTexture2D &target = g_hostTargets[sceneIndex];
+		const RaylibDesktopSceneContext &context = hostScene.context;
+
+		float scale = context.tier.resolutionScale > 0.0f ? context.tier.resolutionScale : 1.0f;
+		int width = std::max(1, (int)(context.monitor.monitorWidth * scale));
+		int height = std::max(1, (int)(context.monitor.monitorHeight * scale));
+
+		// Resize the target when the tier's resolution scale changes
+		if (target.id != 0 && (target.texture.width != width || target.texture.height != height)) {
+			UnloadRenderTexture(target);
+			target = {0};
+		}
+		if (target.id == 0)
+			target = LoadRenderTexture(width, height);
+
+		Camera2D camera = {0};
+		camera.zoom = scale;
+
+		BeginTextureMode(target);
+		BeginMode2D(camera);
+		if (hostScene.scene.draw)
+			hostScene.scene.draw(hostScene.scene.userData, &context);
+		EndMode2D();
+		EndTextureMode();
+
+		hostScene.hasFrame = true;
+	}
+
+	// Every updated scene has been rendered, the list is rebuilt by the next update
+	g_hostRenderJobCount = 0;
+}
+
+void RaylibDesktopHostDraw(void)
+{
+	for (int i = 0; i < g_hostSceneCount; i++) {
+		const HostScene &hostScene = g_hostScenes[i];
+		if (!hostScene.stats.visible || !hostScene.hasFrame)
+			continue;
+
+		// Render textures are flipped vertically
+		const RenderTexture2D &target = g_hostTargets[i];
+		const MonitorInfo &monitor = hostScene.context.monitor;
+		Rectangle source = {0, 0, (float)target.texture.width, -(float)target.texture.height};
+		Rectangle dest = {
+			(float)(monitor.monitorLeftCoordinate - g_hostWindow.monitorLeftCoordinate),
+			(float)(monitor.monitorTopCoordinate - g_hostWindow.monitorTopCoordinate),
+			(float)monitor.monitorWidth,
+			(float)monitor.monitorHeight
+		};
+		DrawTexturePro(target.texture, source, dest, {0, 0}, 0.0f, WHITE);
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "RaylibDesktop.h"
+
+// Internal to RaylibDesktop.cpp: the occlusion buffer and math shared by the Windows window enumeration
+// and headless mode, in a header so the tests can run them on every platform.
+
+// Window rectangle in desktop coordinates, right and bottom are exclusive
+struct OccludedRect
+{
+	int left;
+	int top;
+	int right;
+	int bottom;
+};
+
+// Occluding windows found by one query
+struct FullscreenOcclusionData
+{
+	MonitorInfo monitor; // Queried area (desktop coordinates)
+	OccludedRect occludedRects[RAYLIB_DESKTOP_MAX_OCCLUDING_WINDOWS]; // Parts of the windows inside the area
+	int occludedRectCount; // Number of valid entries in occludedRects
+};
+
+// Clips a window to the queried area and stores it, windows outside the area are skipped.
+// Returns false once the buffer is full, the remaining windows are ignored.
+bool AddOccludedRect(FullscreenOcclusionData *occlusionData, const OccludedRect &windowRect);
+
+// @brief Computes the fraction of the monitor area that is occluded by any rectangle in occludedRects.
+// @param occludedRects An array of rectangles representing occluded regions.
+// @param occludedRectCount The number of rectangles in occludedRects.
+// @param monitor The monitor info (with coordinates relative to your desktop, starting at (0,0)).
+// @param sampleStep The spacing (in pixels) between sample points on the grid.
+// @return A value between 0.0 and 1.0 representing the approximate fraction of the monitor area that is occluded.
+double ComputeOcclusionFraction(
+	const OccludedRect *occludedRects,
+	int occludedRectCount,
+	const MonitorInfo &monitor,
+	int sampleStep = 100
+);
@@ -0,0 +1,113 @@
+#include "RaylibDesktopPolicy.h"
+
+RaylibDesktopQualityPolicy RaylibDesktopDefaultQualityPolicy(void)
+{
+	RaylibDesktopQualityPolicy policy = {};
+
+	policy.tiers[0] = {"Full", 60, 1.0f, RAYLIB_DESKTOP_EFFECT_ALL};
+	policy.tiers[1] = {"Balanced", 30, 1.0f, RAYLIB_DESKTOP_EFFECT_ALL};
+	policy.tiers[2] = {"Saver", 15, 0.5f, RAYLIB_DESKTOP_EFFECT_MOUSE_INTERACTION};
+	policy.tiers[3] = {"Minimal", 5, 0.5f, RAYLIB_DESKTOP_EFFECT_NONE};
+	policy.tierCount = 4;
+
+	policy.batteryTier = 1;
+	policy.batterySaverTier = 2;
+	policy.lowBatteryPercent = 20;
+	policy.userBusyTier = 3;
+	policy.partialOcclusionTier = 1;
+	policy.partialOcclusionThreshold = 0.5;
+	policy.idleTier = 2;
+	policy.idleSeconds = 300.0;
+
+	policy.upgradeDelaySeconds = 2.0;
+
+	return policy;
+}
+
+// Used by policies without any tier, so a misconfigured policy never pauses rendering for good
+static const RaylibDesktopQualityTier g_fallbackTier = {"Full", 60, 1.0f, RAYLIB_DESKTOP_EFFECT_ALL};
+
+// Number of usable tiers, tierCount limited to the size of the tiers array
+static int GetTierCount(const RaylibDesktopQualityPolicy &policy)
+{
+	if (policy.tierCount > RAYLIB_DESKTOP_MAX_QUALITY_TIERS)
+		return RAYLIB_DESKTOP_MAX_QUALITY_TIERS;
+	return policy.tierCount;
+}
+
+// Raises tier to ruleTier if the rule is enabled and asks for a lower quality tier
+static void ApplyRule(int &tier, int ruleTier, bool triggered)
+{
+	if (triggered && ruleTier > tier) {
+		tier = ruleTier;
+	}
+}
+
+int RaylibDesktopEvaluateQualityTier(const RaylibDesktopQualityPolicy &policy, const RaylibDesktopPolicyInputs &inputs)
+{
+	int tier = 0;
+
+	bool lowBattery = inputs.onBattery && inputs.batteryPercent >= 0 && inputs.batteryPercent <= policy.lowBatteryPercent;
+
+	ApplyRule(tier, policy.batteryTier, inputs.onBattery);
+	ApplyRule(tier, policy.batterySaverTier, inputs.batterySaver || lowBattery);
+	ApplyRule(tier, policy.userBusyTier, inputs.userBusy);
+	ApplyRule(tier, policy.partialOcclusionTier, inputs.occlusionFraction >= policy.partialOcclusionThreshold);
+	ApplyRule(tier, policy.idleTier, inputs.inputIdleSeconds >= policy.idleSeconds);
+
+	// Rules may point past the configured tiers, clamp to the lowest quality one
+	int tierCount = GetTierCount(policy);
+	if (tier >= tierCount)
+		tier = tierCount - 1;
+	if (tier < 0)
+		tier = 0;
+
+	return tier;
+}
+
+bool RaylibDesktopUpdateQualityTier(
+	const RaylibDesktopQualityPolicy &policy,
+	RaylibDesktopPolicyState &state,
+	const RaylibDesktopPolicyInputs &inputs,
+	double time
+)
+{
+	int requestedTier = RaylibDesktopEvaluateQualityTier(policy, inputs);
+
+	// First update or lower quality requested: switch immediately to save power as soon as possible
+	if (state.currentTier < 0 || requestedTier > state.currentTier) {
+		bool changed = state.currentTier != requestedTier;
+		state.currentTier = requestedTier;
+		state.pendingTier = -1;
+		return changed;
+	}
+
+	if (requestedTier == state.currentTier) {
+		state.pendingTier = -1;
+		return false;
+	}
+
+	// Higher quality requested: wait until the request is stable to avoid flapping
+	// e.g. when a window is dragged across the occlusion threshold
+	if (state.pendingTier != requestedTier) {
+		state.pendingTier = requestedTier;
+		state.pendingSince = time;
+	}
+
+	if (time - state.pendingSince < policy.upgradeDelaySeconds)
+		return false;
+
+	state.currentTier = requestedTier;
+	state.pendingTier = -1;
+	return true;
+}
+
+const RaylibDesktopQualityTier &
+RaylibDesktopGetQualityTier(const RaylibDesktopQualityPolicy &policy, const RaylibDesktopPolicyState &state)
+{
+	if (GetTierCount(policy) <= 0)
+		return g_fallbackTier;
+	if (state.currentTier < 0 || state.currentTier >= GetTierCount(policy))
+		return policy.tiers[0];
+	return policy.tiers[state.currentTier];
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+// Quality tier policy
+// Combines power and desktop context (battery, notification state, occlusion, idle time)
+// into a discrete quality tier the render loop can apply.
+// The evaluation functions are pure and don't touch any platform API,
+// the inputs are gathered by RaylibDesktopQueryPolicyInputs() in RaylibDesktop.h.
+
+// Maximum number of tiers a policy can hold
+#define RAYLIB_DESKTOP_MAX_QUALITY_TIERS 8
+
+// Effect toggles a tier can enable, combined as a bit mask
+enum RaylibDesktopEffectFlags
+{
+	RAYLIB_DESKTOP_EFFECT_NONE = 0,
+	RAYLIB_DESKTOP_EFFECT_POST_PROCESSING = 1 << 0, // Full screen shaders, bloom, blur...
+	RAYLIB_DESKTOP_EFFECT_PARTICLES = 1 << 1, // Particle systems and other dense animation
+	RAYLIB_DESKTOP_EFFECT_MOUSE_INTERACTION = 1 << 2, // Mouse driven effects
+	RAYLIB_DESKTOP_EFFECT_ALL = 0x7
+};
+
+// A single quality tier
+typedef struct RaylibDesktopQualityTier
+{
+	const char *name; // Name for logging, may be NULL
+	int targetFps; // Frames per second to pass to SetTargetFPS, 0 pauses rendering
+	float resolutionScale; // Scale of the render target relative to the wallpaper size (0.0 - 1.0]
+	unsigned int effectFlags; // Combination of RaylibDesktopEffectFlags
+} RaylibDesktopQualityTier;
+
+// Inputs the policy is evaluated against
+typedef struct RaylibDesktopPolicyInputs
+{
+	bool onBattery; // True when running on battery instead of AC power
+	bool batterySaver; // True when the OS battery saver is enabled
+	int batteryPercent; // Remaining battery charge 0-100, -1 if unknown
+	bool userBusy; // True when a fullscreen app, game or presentation is running
+	double occlusionFraction; // Fraction of the wallpaper covered by other windows (0.0 - 1.0)
+	double inputIdleSeconds; // Seconds since the last keyboard or mouse input
+} RaylibDesktopPolicyInputs;
+
+// Policy configuration
+// Tiers are ordered from highest quality (index 0) to lowest quality.
+// Policies without tiers (tierCount <= 0) use a single 60 FPS full quality tier.
+// Every rule below names the tier it forces when it triggers, the lowest quality triggered tier wins.
+// Set a rule's tier to -1 to disable it.
+typedef struct RaylibDesktopQualityPolicy
+{
+	RaylibDesktopQualityTier tiers[RAYLIB_DESKTOP_MAX_QUALITY_TIERS];
+	int tierCount;
+
+	int batteryTier; // Tier used while on battery
+	int batterySaverTier; // Tier used while battery saver is on or the battery is low
+	int lowBatteryPercent; // Battery charge at or below which batterySaverTier applies
+	int userBusyTier; // Tier used while the user runs a fullscreen app or presentation
+	int partialOcclusionTier; // Tier used while the wallpaper is partially occluded
+	double partialOcclusionThreshold; // Occlusion fraction at or above which partialOcclusionTier applies
+	int idleTier; // Tier used while there is no user input
+	double idleSeconds; // Input idle time after which idleTier applies
+
+	double upgradeDelaySeconds; // Time a higher quality tier must be requested before switching to it
+} RaylibDesktopQualityPolicy;
+
+// Tracks the current tier between evaluations
+// Initialize with {-1, -1, 0.0}
+typedef struct RaylibDesktopPolicyState
+{
+	int currentTier; // Tier currently in use, -1 before the first update
+	int pendingTier; // Higher quality tier waiting for upgradeDelaySeconds, -1 if none
+	double pendingSince; // Time at which pendingTier was first requested
+} RaylibDesktopPolicyState;
+
+// Returns the default policy with four tiers: Full (60 FPS), Balanced (30 FPS), Saver (15 FPS) and Minimal (5 FPS)
+RaylibDesktopQualityPolicy RaylibDesktopDefaultQualityPolicy(void);
+
+// Returns the tier index the inputs map to, without any hysteresis.
+int RaylibDesktopEvaluateQualityTier(const RaylibDesktopQualityPolicy &policy, const RaylibDesktopPolicyInputs &inputs);
+
+// Call this function once per frame (or less often) with the current time in seconds.
+// Switches to lower quality tiers immediately and to higher quality tiers once they have been
+// requested for upgradeDelaySeconds.
+// Returns true if the current tier changed, the new tier is stored in state.currentTier.
+bool RaylibDesktopUpdateQualityTier(
+	const RaylibDesktopQualityPolicy &policy,
+	RaylibDesktopPolicyState &state,
+	const RaylibDesktopPolicyInputs &inputs,
+	double time
+);
+
+// Returns the tier currently in use, or the first tier before the first update
+const RaylibDesktopQualityTier &
+RaylibDesktopGetQualityTier(const RaylibDesktopQualityPolicy &policy, const RaylibDesktopPolicyState &state);
@@ -0,0 +1,70 @@
+#include "AllocationCounter.h"
+
+#include <new>
+#include <stdlib.h>
+
+// The replacements live in their own translation unit, so the compiler never inlines them into the code
+// under test and sees the pointers of operator new passed to free().
+
+static thread_local bool g_countAllocations = false;
+static thread_local long long g_allocationCount = 0;
+
+void BeginCountingAllocations()
+{
+	g_allocationCount = 0;
+	g_countAllocations = true;
+}
+
+long long EndCountingAllocations()
+{
+	g_countAllocations = false;
+	return g_allocationCount;
+}
+
+void *operator new(size_t size)
+{
+	if (g_countAllocations)
+		g_allocationCount++;
+
+	void *memory = malloc(size ? size : 1);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void *operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+	if (g_countAllocations)
+		g_allocationCount++;
+	return malloc(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void *memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+	free(memory);
+}
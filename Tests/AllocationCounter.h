@@ -0,0 +1,11 @@
+#pragma once
+
+// Counts the allocations made by the calling thread, through the global operator new replaced in
+// AllocationCounter.cpp. Link AllocationCounter.cpp into the tests including this header.
+// Only allocations between BeginCountingAllocations() and EndCountingAllocations() on the same thread are
+// counted, so the loader's worker threads or one time initialization don't show up.
+
+void BeginCountingAllocations();
+
+// Returns the number of allocations since BeginCountingAllocations()
+long long EndCountingAllocations();
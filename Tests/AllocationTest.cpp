@@ -0,0 +1,128 @@
+// Per-frame desktop queries must not allocate: runs the headless monitor, occlusion, lock, mouse
+// and quality policy path every frame of the example timeline and fails on any allocation after warm up.
+// The occlusion buffer shared with the Windows window enumeration is also filled past its cap.
+
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "RaylibDesktopHeadless.h"
+#include "RaylibDesktopOcclusion.h"
+#include "Test.h"
+
+#define WARM_UP_FRAMES 10
+#define MEASURED_FRAMES 1000
+
+static int g_sink = 0;
+
+// Everything the render loop queries once per frame
+static void RunFrame(
+	int frame,
+	const RaylibDesktopQualityPolicy &policy,
+	RaylibDesktopPolicyState &policyState
+)
+{
+	RaylibDesktopUpdateMouseState();
+
+	MonitorInfo monitors[RAYLIB_DESKTOP_MAX_MONITORS];
+	int monitorCount = RaylibDesktopGetMonitors(monitors, RAYLIB_DESKTOP_MAX_MONITORS);
+
+	MonitorInfo desktop = GetWallpaperTarget(-1);
+	MonitorInfo firstMonitor = GetWallpaperTarget(0);
+	g_sink += desktop.monitorWidth + firstMonitor.monitorWidth;
+
+	double fractions[RAYLIB_DESKTOP_MAX_MONITORS];
+	GetMonitorOcclusionFractions(monitors, monitorCount, fractions);
+	for (int i = 0; i < monitorCount; i++) {
+		g_sink += GetMonitorOcclusionFraction(monitors[i]) == fractions[i];
+	}
+	g_sink += IsMonitorOccluded(desktop, 0.95);
+	g_sink += IsDesktopLocked();
+
+	g_sink += RaylibDesktopGetMouseX() + RaylibDesktopGetMouseY();
+	for (int button = 0; button < 5; button++) {
+		g_sink += RaylibDesktopIsMouseButtonDown(button) + RaylibDesktopIsMouseButtonPressed(button) +
+				  RaylibDesktopIsMouseButtonReleased(button) + RaylibDesktopIsMouseButtonUp(button);
+	}
+
+	RaylibDesktopPolicyInputs inputs;
+	RaylibDesktopQueryPolicyInputs(desktop, &inputs);
+	RaylibDesktopUpdateQualityTier(policy, policyState, inputs, frame / 60.0);
+	g_sink += RaylibDesktopGetQualityTier(policy, policyState).targetFps;
+}
+
+// More windows than the buffer holds, the way FullscreenWindowEnumProc() adds them
+static void TestOccludedRectCap()
+{
+	static FullscreenOcclusionData occlusionData;
+	occlusionData.monitor = {1920, 0, 1920, 1080};
+	occlusionData.occludedRectCount = 0;
+
+	BeginCountingAllocations();
+
+	// Outside the monitor, skipped without using the buffer
+	OccludedRect outside = {0, 0, 1920, 1080};
+	CHECK(AddOccludedRect(&occlusionData, outside));
+	CHECK_EQUAL(0, occlusionData.occludedRectCount);
+
+	// The left half of the monitor, clipped to it, then small windows until the buffer is full
+	OccludedRect leftHalf = {1000, -100, 2880, 2000};
+	CHECK(AddOccludedRect(&occlusionData, leftHalf));
+	int accepted = 0;
+	for (int i = 0; i < 300; i++) {
+		OccludedRect window = {2880 + i, 550, 2881 + i, 551};
+		accepted += AddOccludedRect(&occlusionData, window);
+	}
+	CHECK_EQUAL(RAYLIB_DESKTOP_MAX_OCCLUDING_WINDOWS, occlusionData.occludedRectCount);
+	// Adding the window that fills the last slot already returns false
+	CHECK_EQUAL(RAYLIB_DESKTOP_MAX_OCCLUDING_WINDOWS - 2, accepted);
+
+	const OccludedRect &clipped = occlusionData.occludedRects[0];
+	CHECK_EQUAL(1920, clipped.left);
+	CHECK_EQUAL(0, clipped.top);
+	CHECK_EQUAL(2880, clipped.right);
+	CHECK_EQUAL(1080, clipped.bottom);
+
+	// A full buffer ignores further windows
+	CHECK(!AddOccludedRect(&occlusionData, leftHalf));
+	CHECK_EQUAL(RAYLIB_DESKTOP_MAX_OCCLUDING_WINDOWS, occlusionData.occludedRectCount);
+
+	// The small windows miss every sample point, the left half covers 10 of the 20 columns
+	double fraction = ComputeOcclusionFraction(
+		occlusionData.occludedRects, occlusionData.occludedRectCount, occlusionData.monitor
+	);
+	CHECK(fraction == 0.5);
+
+	CHECK_EQUAL(0, EndCountingAllocations());
+}
+
+int main()
+{
+	// The counter itself must see allocations
+	BeginCountingAllocations();
+	std::vector<int> *allocated = new std::vector<int>(16);
+	CHECK(EndCountingAllocations() >= 2);
+	delete allocated;
+
+	TestOccludedRectCap();
+
+	CHECK_EQUAL(0, InitRaylibDesktopHeadless(1920, 1080, "../RaylibDesktopDemo/HeadlessTimeline.txt"));
+	ConfigureDesktopPositioning(GetWallpaperTarget(-1));
+
+	RaylibDesktopQualityPolicy policy = RaylibDesktopDefaultQualityPolicy();
+	RaylibDesktopPolicyState policyState = {-1, -1, 0.0};
+
+	int frame = 0;
+	for (; frame < WARM_UP_FRAMES; frame++) {
+		RunFrame(frame, policy, policyState);
+	}
+
+	// Covers every event of the timeline: cursor, buttons, per-monitor occlusion and the lock
+	BeginCountingAllocations();
+	for (; frame < WARM_UP_FRAMES + MEASURED_FRAMES; frame++) {
+		RunFrame(frame, policy, policyState);
+	}
+	CHECK_EQUAL(0, EndCountingAllocations());
+
+	CleanupRaylibDesktop();
+	return TestResult("AllocationTest");
+}
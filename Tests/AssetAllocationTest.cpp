@@ -0,0 +1,55 @@
+// The loader's per-frame calls must not allocate once an image is cached:
+// RaylibDesktopGetImageTexture() looks entries up by const char * and RaylibDesktopUploadImages() has nothing to do.
+// Needs raylib and a GL context, e.g. LIBGL_ALWAYS_SOFTWARE=1 xvfb-run build/AssetAllocationTest
+
+#include "AllocationCounter.h"
+#include "RaylibDesktopAssets.h"
+#include "Test.h"
+
+#define MEASURED_FRAMES 1000
+
+int main()
+{
+	SetTraceLogLevel(LOG_WARNING);
+	SetConfigFlags(FLAG_WINDOW_HIDDEN);
+	InitWindow(320, 240, "AssetAllocationTest");
+
+	const char *fileNames[] = {"build/allocation0.png", "build/allocation1.png"};
+	for (const char *fileName : fileNames) {
+		Image image = GenImageColor(512, 512, ORANGE);
+		ExportImage(image, fileName);
+		UnloadImage(image);
+	}
+
+	InitRaylibDesktopAssetLoader(NULL);
+	RaylibDesktopPrefetchSlides(fileNames, 2, 0, 1);
+
+	// Decode and upload both images, 5 seconds at most
+	Texture2D texture = {0};
+	double deadline = GetTime() + 5.0;
+	int readyCount = 0;
+	while (readyCount < 2 && GetTime() < deadline) {
+		readyCount += RaylibDesktopUploadImages(0.004);
+		WaitTime(0.001);
+	}
+	CHECK_EQUAL(2, readyCount);
+
+	// Warm up
+	RaylibDesktopUploadImages(0.004);
+	RaylibDesktopGetImageTexture(fileNames[0], &texture);
+	RaylibDesktopGetAssetLoaderStats();
+
+	BeginCountingAllocations();
+	int found = 0;
+	for (int frame = 0; frame < MEASURED_FRAMES; frame++) {
+		RaylibDesktopUploadImages(0.004);
+		found += RaylibDesktopGetImageTexture(fileNames[frame % 2], &texture);
+		found += RaylibDesktopGetImageTexture("build/not-requested.png", &texture);
+	}
+	CHECK_EQUAL(0, EndCountingAllocations());
+	CHECK_EQUAL(MEASURED_FRAMES, found);
+
+	CleanupRaylibDesktopAssetLoader();
+	CloseWindow();
+	return TestResult("AssetAllocationTest");
+}
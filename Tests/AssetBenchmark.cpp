@@ -0,0 +1,240 @@
+// Slideshow hitch benchmark: synchronous LoadTexture() on slide changes versus the asynchronous loader
+// with RaylibDesktopUploadImages() and a per-frame budget. Prints the frame time percentiles of both.
+// The images are read once before measuring and the order of the two passes alternates every round,
+// so neither of them pays for a cold file cache.
+//
+// AssetBenchmark [--images <directory>] [--frames <count>] [--interval <frames>] [--budget <ms>] [--rounds <count>]
+// Without --images, six 8K images are generated into build/images.
+// Needs a GL context, e.g. LIBGL_ALWAYS_SOFTWARE=1 xvfb-run build/AssetBenchmark
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "RaylibDesktopAssets.h"
+
+struct BenchmarkOptions
+{
+	const char *images = NULL;
+	int frames = 600;
+	int interval = 60;
+	double budgetSeconds = 0.004;
+	int rounds = 2; // Each round runs both passes, odd rounds start with the asynchronous one
+};
+
+static double Percentile(const std::vector<double> &sortedValues, double percentile)
+{
+	if (sortedValues.empty())
+		return 0.0;
+	size_t index = static_cast<size_t>(percentile / 100.0 * (sortedValues.size() - 1) + 0.5);
+	return sortedValues[index];
+}
+
+static void PrintFrameTimes(const char *name, std::vector<double> frameTimes)
+{
+	std::sort(frameTimes.begin(), frameTimes.end());
+	printf(
+		"%-8s frame time ms: p50 %.3f, p99 %.3f, max %.3f\n",
+		name,
+		Percentile(frameTimes, 50.0) * 1000.0,
+		Percentile(frameTimes, 99.0) * 1000.0,
+		(frameTimes.empty() ? 0.0 : frameTimes.back()) * 1000.0
+	);
+}
+
+// Writes large QOI images with a different pattern each, so every slide has to be decoded and uploaded
+static std::vector<std::string> GenerateImages()
+{
+	static const Color colors[] = {RED, ORANGE, GREEN, SKYBLUE, PURPLE, GOLD};
+
+	std::vector<std::string> fileNames;
+	MakeDirectory("build/images");
+	for (int i = 0; i < 6; i++) {
+		std::string fileName = TextFormat("build/images/slide%d.qoi", i);
+		if (!FileExists(fileName.c_str())) {
+			Image image = GenImageChecked(7680, 4320, 64 * (i + 1), 64 * (i + 1), colors[i], RAYWHITE);
+			ExportImage(image, fileName.c_str());
+			UnloadImage(image);
+		}
+		fileNames.push_back(fileName);
+	}
+	return fileNames;
+}
+
+// Reads every slide once, the first pass would otherwise also measure the disk
+static void WarmFileCache(const std::vector<const char *> &slides)
+{
+	for (const char *slide : slides) {
+		int size = 0;
+		unsigned char *data = LoadFileData(slide, &size);
+		UnloadFileData(data);
+	}
+}
+
+static void DrawSlide(Texture2D texture)
+{
+	BeginDrawing();
+	ClearBackground(BLACK);
+	if (texture.id != 0) {
+		Rectangle source = {0, 0, (float)texture.width, (float)texture.height};
+		Rectangle dest = {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()};
+		DrawTexturePro(texture, source, dest, {0, 0}, 0.0f, WHITE);
+	}
+	EndDrawing();
+}
+
+// Loads every slide on the render thread when it is shown
+static std::vector<double> RunSynchronous(const BenchmarkOptions &options, const std::vector<const char *> &slides)
+{
+	std::vector<double> frameTimes;
+	Texture2D texture = {0};
+
+	for (int frame = 0; frame < options.frames; frame++) {
+		double frameStart = GetTime();
+
+		if (frame % options.interval == 0) {
+			if (texture.id != 0)
+				UnloadTexture(texture);
+			texture = LoadTexture(slides[(frame / options.interval) % slides.size()]);
+		}
+		DrawSlide(texture);
+
+		frameTimes.push_back(GetTime() - frameStart);
+	}
+
+	if (texture.id != 0)
+		UnloadTexture(texture);
+	return frameTimes;
+}
+
+// Decodes in the background and uploads within the budget, the slide is shown once it is ready
+static std::vector<double>
+RunAsynchronous(const BenchmarkOptions &options, const std::vector<const char *> &slides, double *averageDelayFrames)
+{
+	std::vector<double> frameTimes;
+	int currentSlide = 0;
+	int changeFrame = 0;
+	int shownSlides = 0;
+	long long delayFrames = 0;
+	bool shown = false;
+
+	InitRaylibDesktopAssetLoader(NULL);
+	RaylibDesktopPrefetchSlides(slides.data(), (int)slides.size(), currentSlide, 2);
+
+	for (int frame = 0; frame < options.frames; frame++) {
+		double frameStart = GetTime();
+
+		if (frame > 0 && frame % options.interval == 0) {
+			currentSlide = (currentSlide + 1) % (int)slides.size();
+			RaylibDesktopPrefetchSlides(slides.data(), (int)slides.size(), currentSlide, 2);
+			changeFrame = frame;
+			shown = false;
+		}
+
+		RaylibDesktopUploadImages(options.budgetSeconds);
+
+		Texture2D texture = {0};
+		if (RaylibDesktopGetImageTexture(slides[currentSlide], &texture) && !shown) {
+			shown = true;
+			shownSlides++;
+			delayFrames += frame - changeFrame;
+		}
+		DrawSlide(texture);
+
+		frameTimes.push_back(GetTime() - frameStart);
+	}
+
+	CleanupRaylibDesktopAssetLoader();
+	*averageDelayFrames = shownSlides > 0 ? (double)delayFrames / shownSlides : 0.0;
+	return frameTimes;
+}
+
+int main(int argc, char **argv)
+{
+	BenchmarkOptions options;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "--images") == 0)
+			options.images = argv[i + 1];
+		else if (strcmp(argv[i], "--frames") == 0)
+			options.frames = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--interval") == 0)
+			options.interval = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--budget") == 0)
+			options.budgetSeconds = atof(argv[i + 1]) / 1000.0;
+		else if (strcmp(argv[i], "--rounds") == 0)
+			options.rounds = atoi(argv[i + 1]);
+	}
+	if (options.frames <= 0 || options.interval <= 0 || options.rounds <= 0) {
+		fprintf(stderr, "Usage: AssetBenchmark [--images <directory>] [--frames <count>] [--interval <frames>] "
+						"[--budget <ms>] [--rounds <count>]\n");
+		return 1;
+	}
+
+	SetTraceLogLevel(LOG_WARNING);
+	SetConfigFlags(FLAG_WINDOW_HIDDEN);
+	InitWindow(1920, 1080, "AssetBenchmark");
+	SetTargetFPS(0);
+
+	std::vector<std::string> fileNames;
+	if (options.images) {
+		FilePathList files = LoadDirectoryFiles(options.images);
+		for (unsigned int i = 0; i < files.count; i++) {
+			if (IsFileExtension(files.paths[i], ".png;.jpg;.jpeg;.bmp;.qoi"))
+				fileNames.push_back(files.paths[i]);
+		}
+		UnloadDirectoryFiles(files);
+	}
+	else {
+		fileNames = GenerateImages();
+	}
+
+	if (fileNames.empty()) {
+		fprintf(stderr, "No images found\n");
+		CloseWindow();
+		return 1;
+	}
+
+	std::vector<const char *> slides;
+	for (const std::string &fileName : fileNames) {
+		slides.push_back(fileName.c_str());
+	}
+
+	printf(
+		"%d slides, %d frames, slide change every %d frames, upload budget %.1f ms, %d rounds\n",
+		(int)slides.size(),
+		options.frames,
+		options.interval,
+		options.budgetSeconds * 1000.0,
+		options.rounds
+	);
+
+	WarmFileCache(slides);
+
+	std::vector<double> synchronousFrameTimes;
+	std::vector<double> asynchronousFrameTimes;
+	double delaySum = 0.0;
+	for (int round = 0; round < options.rounds; round++) {
+		for (int pass = 0; pass < 2; pass++) {
+			if ((pass + round) % 2 == 0) {
+				std::vector<double> frameTimes = RunSynchronous(options, slides);
+				synchronousFrameTimes.insert(synchronousFrameTimes.end(), frameTimes.begin(), frameTimes.end());
+			}
+			else {
+				double averageDelayFrames = 0.0;
+				std::vector<double> frameTimes = RunAsynchronous(options, slides, &averageDelayFrames);
+				asynchronousFrameTimes.insert(asynchronousFrameTimes.end(), frameTimes.begin(), frameTimes.end());
+				delaySum += averageDelayFrames;
+			}
+		}
+	}
+
+	PrintFrameTimes("sync", synchronousFrameTimes);
+	PrintFrameTimes("async", asynchronousFrameTimes);
+	printf("async slide delay: %.1f frames on average\n", delaySum / options.rounds);
+
+	CloseWindow();
+	return 0;
+}
@@ -0,0 +1,130 @@
+// Audio analysis benchmark: RealFft::Magnitudes() throughput at the default and the largest FFT size,
+// then the latency of the published spectrum while a generated WAV file plays through
+// InitRaylibDesktopAudioFromWave(): publishTime - captureTime (analysis) and the time until a
+// render loop polling every millisecond reads it.
+//
+// AudioBenchmark [--seconds <duration of each latency run>]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "RaylibDesktopAudio.h"
+#include "RaylibDesktopAudioFft.h"
+#include "WaveFile.h"
+
+#define WAVE_FILE "build/benchmark.wav"
+#define WAVE_SAMPLE_RATE 48000
+
+// Keeps the benchmarked results alive
+static volatile float g_sink = 0.0f;
+
+static double Percentile(const std::vector<double> &sortedValues, double percentile)
+{
+	if (sortedValues.empty())
+		return 0.0;
+	size_t index = static_cast<size_t>(percentile / 100.0 * (sortedValues.size() - 1) + 0.5);
+	return sortedValues[index];
+}
+
+static void PrintLatencies(const char *name, std::vector<double> latencies)
+{
+	std::sort(latencies.begin(), latencies.end());
+	printf(
+		"  %-8s latency ms: p50 %.3f, p99 %.3f, max %.3f\n",
+		name,
+		Percentile(latencies, 50.0) * 1000.0,
+		Percentile(latencies, 99.0) * 1000.0,
+		(latencies.empty() ? 0.0 : latencies.back()) * 1000.0
+	);
+}
+
+static void BenchmarkMagnitudes(int size)
+{
+	RealFft fft;
+	fft.Init(size);
+
+	std::vector<float> input(size);
+	for (int n = 0; n < size; n++) {
+		input[n] = static_cast<float>(std::sin(n * 0.05) + 0.25 * std::sin(n * 0.71));
+	}
+	std::vector<float> magnitudes(fft.half);
+
+	// Warm up, then run for at least half a second
+	fft.Magnitudes(input.data(), magnitudes.data());
+	int iterations = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	double elapsed = 0.0;
+	while (elapsed < 0.5) {
+		for (int i = 0; i < 100; i++) {
+			fft.Magnitudes(input.data(), magnitudes.data());
+			g_sink = g_sink + magnitudes[i % fft.half];
+		}
+		iterations += 100;
+		elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	double microseconds = elapsed / iterations * 1e6;
+	printf("Magnitudes(%d): %.2f us per call, %.1f M samples/s\n", size, microseconds, size / microseconds);
+}
+
+static void BenchmarkLatency(int fftSize, double seconds)
+{
+	RaylibDesktopAudioConfig config = RaylibDesktopDefaultAudioConfig();
+	config.fftSize = fftSize;
+	if (InitRaylibDesktopAudioFromWave(WAVE_FILE, &config) != 0) {
+		fprintf(stderr, "Can't play %s\n", WAVE_FILE);
+		return;
+	}
+
+	std::vector<double> analysis;
+	std::vector<double> read;
+	RaylibDesktopAudioSpectrum spectrum;
+	double end = RaylibDesktopGetAudioTime() + seconds;
+	while (RaylibDesktopGetAudioTime() < end) {
+		if (RaylibDesktopGetAudioSpectrum(&spectrum)) {
+			analysis.push_back(spectrum.publishTime - spectrum.captureTime);
+			read.push_back(RaylibDesktopGetAudioTime() - spectrum.captureTime);
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	CleanupRaylibDesktopAudio();
+
+	printf("FFT size %d, %d snapshots in %.1f s\n", fftSize, (int)analysis.size(), seconds);
+	PrintLatencies("analysis", analysis);
+	PrintLatencies("read", read);
+}
+
+int main(int argc, char **argv)
+{
+	double seconds = 3.0;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "--seconds") == 0)
+			seconds = atof(argv[i + 1]);
+	}
+	if (seconds <= 0.0) {
+		fprintf(stderr, "Usage: AudioBenchmark [--seconds <duration of each latency run>]\n");
+		return 1;
+	}
+
+#ifdef RAYLIB_DESKTOP_FFT_SSE
+	printf("FFT butterflies: SSE\n");
+#else
+	printf("FFT butterflies: scalar\n");
+#endif
+	BenchmarkMagnitudes(RaylibDesktopDefaultAudioConfig().fftSize);
+	BenchmarkMagnitudes(16384);
+
+	if (!WriteWave(WAVE_FILE, WAVE_SAMPLE_RATE, 2.0)) {
+		fprintf(stderr, "Can't write %s\n", WAVE_FILE);
+		return 1;
+	}
+	BenchmarkLatency(RaylibDesktopDefaultAudioConfig().fftSize, seconds);
+	BenchmarkLatency(16384, seconds);
+	return 0;
+}
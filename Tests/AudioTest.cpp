@@ -0,0 +1,54 @@
+// WAV audio source: a second Init while audio is running fails, and every published spectrum carries the
+// capture time of the window it analysed, which never runs ahead of its publish time or goes backwards.
+// Run it with SANITIZE=thread to check the sample ring and the spectrum hand-off.
+
+#include <chrono>
+#include <thread>
+
+#include "RaylibDesktopAudio.h"
+#include "Test.h"
+#include "WaveFile.h"
+
+#define WAVE_FILE "build/audiotest.wav"
+#define WAVE_SAMPLE_RATE 48000
+#define RUN_SECONDS 0.5
+
+static void TestSpectrumTimes()
+{
+	RaylibDesktopAudioSpectrum spectrum;
+	int snapshots = 0;
+	double lastCaptureTime = 0.0;
+	double end = RaylibDesktopGetAudioTime() + RUN_SECONDS;
+	while (RaylibDesktopGetAudioTime() < end) {
+		if (RaylibDesktopGetAudioSpectrum(&spectrum)) {
+			CHECK(spectrum.captureTime > 0.0);
+			CHECK(spectrum.captureTime <= spectrum.publishTime);
+			CHECK(spectrum.captureTime >= lastCaptureTime);
+			lastCaptureTime = spectrum.captureTime;
+			snapshots++;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	CHECK(snapshots > 0);
+}
+
+int main()
+{
+	CHECK(WriteWave(WAVE_FILE, WAVE_SAMPLE_RATE, 1.0));
+
+	CHECK_EQUAL(-1, InitRaylibDesktopAudioFromWave("missing.wav", NULL));
+	CHECK_EQUAL(0, InitRaylibDesktopAudioFromWave(WAVE_FILE, NULL));
+
+	// Already running, the threads of the first call keep running
+	CHECK_EQUAL(-1, InitRaylibDesktopAudioFromWave(WAVE_FILE, NULL));
+	CHECK_EQUAL(-1, InitRaylibDesktopAudioLoopback(NULL));
+	TestSpectrumTimes();
+	CleanupRaylibDesktopAudio();
+
+	// Restarts after cleanup
+	CHECK_EQUAL(0, InitRaylibDesktopAudioFromWave(WAVE_FILE, NULL));
+	TestSpectrumTimes();
+	CleanupRaylibDesktopAudio();
+
+	return TestResult("AudioTest");
+}
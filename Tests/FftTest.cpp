@@ -0,0 +1,109 @@
+// RealFft against a double precision DFT of the same windowed input, at sizes exercising the scalar butterflies
+// (spans below 4), the SSE butterflies and the split step. Built twice by the Makefile:
+// FftTest with the SSE path, FftScalarTest with -DRAYLIB_DESKTOP_FFT_NO_SSE.
+
+#include <cmath>
+#include <stdint.h>
+#include <vector>
+
+#include "RaylibDesktopAudioFft.h"
+#include "Test.h"
+
+// Largest error allowed, relative to the largest magnitude of the spectrum
+#define RELATIVE_TOLERANCE 1e-4
+
+// Reproducible white noise in [-1, 1)
+static float NextNoise(uint32_t &state)
+{
+	state = state * 1664525u + 1013904223u;
+	return static_cast<float>(state >> 8) / static_cast<float>(1 << 23) - 1.0f;
+}
+
+// Magnitude of bin k of the windowed input, scaled like RealFft::Magnitudes()
+static double ReferenceMagnitude(const RealFft &fft, const std::vector<float> &input, int k)
+{
+	double sumRe = 0.0;
+	double sumIm = 0.0;
+	for (int n = 0; n < fft.size; n++) {
+		double sample = static_cast<double>(input[n]) * fft.window[n];
+		double angle = -2.0 * AUDIO_PI * static_cast<double>(static_cast<long long>(k) * n % fft.size) / fft.size;
+		sumRe += sample * std::cos(angle);
+		sumIm += sample * std::sin(angle);
+	}
+	return std::sqrt(sumRe * sumRe + sumIm * sumIm) * 2.0 / fft.windowSum;
+}
+
+// Compares every binStep-th bin, large sizes skip bins to keep the O(N^2) reference fast
+static void CheckAgainstReference(RealFft &fft, const std::vector<float> &input, int binStep)
+{
+	std::vector<float> magnitudes(fft.half);
+	fft.Magnitudes(input.data(), magnitudes.data());
+
+	// The peak comes from every bin, the skipped bins may hold it
+	double peak = 1e-9;
+	for (int k = 0; k < fft.half; k++) {
+		peak = std::max(peak, static_cast<double>(magnitudes[k]));
+	}
+
+	std::vector<double> reference;
+	for (int k = 0; k < fft.half; k += binStep) {
+		reference.push_back(ReferenceMagnitude(fft, input, k));
+	}
+
+	double maxError = 0.0;
+	int worstBin = 0;
+	for (int k = 0, i = 0; k < fft.half; k += binStep, i++) {
+		double error = std::fabs(magnitudes[k] - reference[i]);
+		if (error > maxError) {
+			maxError = error;
+			worstBin = k;
+		}
+	}
+	if (maxError > RELATIVE_TOLERANCE * peak) {
+		fprintf(stderr, "size %d: bin %d is off by %g (peak %g)\n", fft.size, worstBin, maxError, peak);
+	}
+	CHECK(maxError <= RELATIVE_TOLERANCE * peak);
+}
+
+static void TestSize(int size)
+{
+	RealFft fft;
+	fft.Init(size);
+	int binStep = size > 4096 ? 61 : 1;
+	std::vector<float> input(size);
+
+	// Sine centered on a bin, its magnitude is its amplitude
+	int bin = size / 8 + 3;
+	for (int n = 0; n < size; n++) {
+		input[n] = 0.5f * static_cast<float>(std::sin(2.0 * AUDIO_PI * bin * n / size));
+	}
+	CheckAgainstReference(fft, input, binStep);
+	std::vector<float> magnitudes(fft.half);
+	fft.Magnitudes(input.data(), magnitudes.data());
+	CHECK(std::fabs(magnitudes[bin] - 0.5f) < 0.005f);
+
+	// Off-bin sine with a DC offset, leaks into every bin and fills bin 0, whose mirror is itself
+	for (int n = 0; n < size; n++) {
+		input[n] = 0.25f + 0.5f * static_cast<float>(std::cos(2.0 * AUDIO_PI * (bin + 0.37) * n / size));
+	}
+	CheckAgainstReference(fft, input, binStep);
+
+	// Noise covers every bin and both halves of the split step
+	uint32_t state = static_cast<uint32_t>(size);
+	for (int n = 0; n < size; n++) {
+		input[n] = NextNoise(state);
+	}
+	CheckAgainstReference(fft, input, binStep);
+}
+
+int main()
+{
+	for (int size = 64; size <= 16384; size *= 2) {
+		TestSize(size);
+	}
+#ifdef RAYLIB_DESKTOP_FFT_SSE
+	return TestResult("FftTest");
+#else
+	return TestResult("FftScalarTest");
+#endif
+}
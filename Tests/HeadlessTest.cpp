@@ -0,0 +1,54 @@
+// Timeline loading: valid layouts and policy inputs load, monitors without a size, occlusion events of monitors
+// that don't exist and out of range policy inputs fail with the file and line.
+
+#include <stdio.h>
+
+#include "RaylibDesktopHeadless.h"
+#include "Test.h"
+
+#define TIMELINE_FILE "build/headlesstest.txt"
+
+// Writes the timeline and loads it, returns the result of InitRaylibDesktopHeadless()
+static int LoadTimeline(const char *timeline)
+{
+	FILE *file = fopen(TIMELINE_FILE, "w");
+	if (!file)
+		return -2;
+	fputs(timeline, file);
+	fclose(file);
+
+	int result = InitRaylibDesktopHeadless(1920, 1080, TIMELINE_FILE);
+	CleanupRaylibDesktop();
+	return result;
+}
+
+int main()
+{
+	// Monitors declared after the occlusion event still count
+	CHECK_EQUAL(0, LoadTimeline("0 occlusion 0.5 1\n0 monitor 0 0 1920 1080\n0 monitor 1920 0 1920 1080\n"));
+	CHECK_EQUAL(-1, LoadTimeline("0 occlusion 0.5 2\n0 monitor 0 0 1920 1080\n0 monitor 1920 0 1920 1080\n"));
+	CHECK_EQUAL(-1, LoadTimeline("0 monitor 0 0 1920 1080\n60 occlusion 1.0 1\n"));
+
+	// Without monitor lines there is the single default monitor
+	CHECK_EQUAL(0, LoadTimeline("60 occlusion 1.0 0\n120 occlusion 0.0\n"));
+	CHECK_EQUAL(-1, LoadTimeline("60 occlusion 1.0 1\n"));
+	CHECK_EQUAL(-1, LoadTimeline("60 occlusion 1.0 -2\n"));
+
+	// Monitors need a positive size
+	CHECK_EQUAL(-1, LoadTimeline("0 monitor 0 0 0 1080\n"));
+	CHECK_EQUAL(-1, LoadTimeline("0 monitor 0 0 1920 -1080\n"));
+
+	// Quality policy inputs
+	CHECK_EQUAL(0, LoadTimeline("10 power battery\n20 power battery 15\n30 power ac\n"));
+	CHECK_EQUAL(0, LoadTimeline("40 saver 1\n50 busy 1\n60 idle 12.5\n"));
+	CHECK_EQUAL(-1, LoadTimeline("10 power solar\n"));
+	CHECK_EQUAL(-1, LoadTimeline("10 power battery 150\n"));
+	CHECK_EQUAL(-1, LoadTimeline("10 idle -1\n"));
+
+	CHECK_EQUAL(0, LoadTimeline(""));
+	CHECK_EQUAL(0, InitRaylibDesktopHeadless(1920, 1080, "../RaylibDesktopDemo/HeadlessTimeline.txt"));
+	CHECK_EQUAL(0, InitRaylibDesktopHeadless(1920, 1080, "HostTimeline.txt"));
+	CleanupRaylibDesktop();
+
+	return TestResult("HeadlessTest");
+}
@@ -0,0 +1,205 @@
+// Multi-wallpaper host scheduling: drives RaylibDesktopHostUpdate() with the simulated 60 FPS clock over
+// HostTimeline.txt and checks each scene's updates and culled frames at the 60, 30 and 15 FPS tiers,
+// the per-monitor culling, the cursor fan-out and that a frame doesn't allocate after warm up.
+// HostPolicyTimeline.txt then switches the power, busy and idle inputs and checks the tier transitions.
+// Only the scheduling is linked, no GL context is needed. Run it with SANITIZE=thread to check the update pool.
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "AllocationCounter.h"
+#include "RaylibDesktopHeadless.h"
+#include "RaylibDesktopHost.h"
+#include "Test.h"
+
+#define FRAMES 480
+#define WARM_UP_FRAMES 10
+
+// Long enough for the pool threads to wake up and claim scenes, so the sanitizer sees them run
+#define UPDATE_MICROSECONDS 200
+
+// Visible stretches of the half covered second monitor: until the lock at frame 300 and after the unlock at 360
+#define FIRST_STRETCH_FRAMES 300
+#define SECOND_STRETCH_FRAMES (FRAMES - 360)
+
+// Written by the scene's update callback on a pool thread, read after RaylibDesktopHostUpdate() returns
+struct TestScene
+{
+	int updates;
+	int mouseInsideUpdates;
+	int mouseX;
+	int mouseY;
+	int wrongDeltaTimes; // Updates whose deltaTime isn't one period of the tier
+	int poolUpdates; // Updates that ran on a pool thread
+};
+
+static std::thread::id g_mainThread;
+
+static void UpdateTestScene(void *userData, const RaylibDesktopSceneContext *context)
+{
+	TestScene *scene = static_cast<TestScene *>(userData);
+	scene->updates++;
+	scene->mouseInsideUpdates += context->mouseInside;
+	scene->mouseX = context->mouseX;
+	scene->mouseY = context->mouseY;
+
+	// The first update of a visible stretch has no previous update
+	if (context->deltaTime > 0.0f && std::fabs(context->deltaTime - 1.0f / context->tier.targetFps) > 0.001f)
+		scene->wrongDeltaTimes++;
+
+	if (std::this_thread::get_id() != g_mainThread)
+		scene->poolUpdates++;
+
+	std::chrono::steady_clock::time_point end =
+		std::chrono::steady_clock::now() + std::chrono::microseconds(UPDATE_MICROSECONDS);
+	while (std::chrono::steady_clock::now() < end) {
+	}
+}
+
+// Updates of a scene at targetFps over a visible stretch, the first frame of the stretch always updates
+static int ExpectedUpdates(int visibleFrames, int targetFps)
+{
+	int framesPerUpdate = 60 / targetFps;
+	return (visibleFrames + framesPerUpdate - 1) / framesPerUpdate;
+}
+
+// Runs the timeline with the second monitor's partial occlusion mapped to partialOcclusionTier
+static void TestTier(int partialOcclusionTier, int expectedFps, int threadCount)
+{
+	CHECK_EQUAL(0, InitRaylibDesktopHeadless(1920, 1080, "HostTimeline.txt"));
+
+	RaylibDesktopHostConfig config = RaylibDesktopDefaultHostConfig();
+	config.updateThreadCount = threadCount;
+	config.policy.partialOcclusionTier = partialOcclusionTier;
+	CHECK_EQUAL(expectedFps, config.policy.tiers[partialOcclusionTier].targetFps);
+	InitRaylibDesktopHost(GetWallpaperTarget(-1), &config);
+
+	MonitorInfo monitors[RAYLIB_DESKTOP_MAX_MONITORS];
+	CHECK_EQUAL(3, RaylibDesktopGetMonitors(monitors, RAYLIB_DESKTOP_MAX_MONITORS));
+
+	TestScene scenes[3] = {};
+	for (int i = 0; i < 3; i++) {
+		RaylibDesktopScene scene = {&scenes[i], UpdateTestScene, NULL, NULL};
+		CHECK_EQUAL(i, RaylibDesktopHostAddScene(monitors[i], scene));
+	}
+
+	for (int frame = 1; frame <= FRAMES; frame++) {
+		if (frame == WARM_UP_FRAMES + 1)
+			BeginCountingAllocations();
+
+		RaylibDesktopUpdateMouseState();
+		RaylibDesktopHostUpdate(frame / 60.0);
+	}
+	CHECK_EQUAL(0, EndCountingAllocations());
+
+	RaylibDesktopSceneStats stats[3];
+	for (int i = 0; i < 3; i++) {
+		CHECK(RaylibDesktopHostGetSceneStats(i, &stats[i]));
+		CHECK_EQUAL(stats[i].updates, scenes[i].updates);
+		CHECK_EQUAL(0, scenes[i].wrongDeltaTimes);
+	}
+	CHECK(!RaylibDesktopHostGetSceneStats(3, &stats[0]));
+
+	// The updates due in the same frame are spread over the pool
+	int poolUpdates = scenes[0].poolUpdates + scenes[1].poolUpdates;
+	if (threadCount > 0)
+		CHECK(poolUpdates > 0);
+	else
+		CHECK_EQUAL(0, poolUpdates);
+
+	// First monitor: full quality, culled while covered and while locked
+	CHECK_EQUAL(0, stats[0].currentTier);
+	CHECK_EQUAL(120, stats[0].culledFrames);
+	CHECK_EQUAL(FRAMES - 120, stats[0].updates);
+	CHECK_EQUAL(0, scenes[0].mouseInsideUpdates);
+
+	// Second monitor: runs at the partial occlusion tier, culled only while locked
+	CHECK_EQUAL(partialOcclusionTier, stats[1].currentTier);
+	CHECK_EQUAL(60, stats[1].culledFrames);
+	CHECK_EQUAL(
+		ExpectedUpdates(FIRST_STRETCH_FRAMES, expectedFps) + ExpectedUpdates(SECOND_STRETCH_FRAMES, expectedFps),
+		stats[1].updates
+	);
+
+	// The cursor at 2000, 100 is reported relative to the second monitor only
+	CHECK_EQUAL(scenes[1].updates, scenes[1].mouseInsideUpdates);
+	CHECK_EQUAL(80, scenes[1].mouseX);
+	CHECK_EQUAL(100, scenes[1].mouseY);
+
+	// Third monitor: covered for the whole run, never updated
+	CHECK(!stats[2].visible);
+	CHECK_EQUAL(FRAMES, stats[2].culledFrames);
+	CHECK_EQUAL(0, stats[2].updates);
+
+	CHECK_EQUAL(60, RaylibDesktopHostGetTargetFps());
+
+	CleanupRaylibDesktopHost();
+	CHECK_EQUAL(0, RaylibDesktopHostGetSceneCount());
+	CleanupRaylibDesktop();
+}
+
+// Frames of HostPolicyTimeline.txt and the tier expected there, away from the policy queries every 60 frames
+struct TierCheckpoint
+{
+	int frame;
+	int tier;
+};
+
+static const TierCheckpoint g_tierCheckpoints[] = {
+	{90, 0}, // AC power
+	{150, 1}, // On battery
+	{250, 2}, // Low battery
+	{400, 2}, // Back on AC power, waiting for the upgrade delay
+	{490, 0},
+	{560, 2}, // Battery saver
+	{790, 0},
+	{860, 3}, // Fullscreen app
+	{1090, 0},
+	{1160, 2}, // Idle
+	{1390, 0},
+};
+
+static void TestPolicyTimeline()
+{
+	CHECK_EQUAL(0, InitRaylibDesktopHeadless(1920, 1080, "HostPolicyTimeline.txt"));
+
+	RaylibDesktopHostConfig config = RaylibDesktopDefaultHostConfig();
+	InitRaylibDesktopHost(GetWallpaperTarget(-1), &config);
+
+	TestScene scene = {};
+	RaylibDesktopScene hostScene = {&scene, UpdateTestScene, NULL, NULL};
+	CHECK_EQUAL(0, RaylibDesktopHostAddScene(GetWallpaperTarget(0), hostScene));
+
+	int frame = 1;
+	for (const TierCheckpoint &checkpoint : g_tierCheckpoints) {
+		for (; frame <= checkpoint.frame; frame++) {
+			RaylibDesktopUpdateMouseState();
+			RaylibDesktopHostUpdate(frame / 60.0);
+		}
+
+		RaylibDesktopSceneStats stats;
+		CHECK(RaylibDesktopHostGetSceneStats(0, &stats));
+		if (stats.currentTier != checkpoint.tier)
+			fprintf(stderr, "frame %d: ", checkpoint.frame);
+		CHECK_EQUAL(checkpoint.tier, stats.currentTier);
+	}
+
+	CleanupRaylibDesktopHost();
+	CleanupRaylibDesktop();
+}
+
+int main()
+{
+	g_mainThread = std::this_thread::get_id();
+
+	TestTier(0, 60, 3);
+	TestTier(1, 30, 3);
+	TestTier(2, 15, 3);
+
+	// Main thread only
+	TestTier(2, 15, 0);
+
+	TestPolicyTimeline();
+	return TestResult("HostTest");
+}
@@ -0,0 +1,172 @@
+// Quality tier policy: rule selection, clamping and the upgrade hysteresis, driven with mocked inputs.
+
+#include "RaylibDesktopPolicy.h"
+#include "Test.h"
+
+static RaylibDesktopPolicyInputs IdleDesktop()
+{
+	RaylibDesktopPolicyInputs inputs;
+	inputs.onBattery = false;
+	inputs.batterySaver = false;
+	inputs.batteryPercent = -1;
+	inputs.userBusy = false;
+	inputs.occlusionFraction = 0.0;
+	inputs.inputIdleSeconds = 0.0;
+	return inputs;
+}
+
+static void TestRules()
+{
+	RaylibDesktopQualityPolicy policy = RaylibDesktopDefaultQualityPolicy();
+	RaylibDesktopPolicyInputs inputs = IdleDesktop();
+	CHECK_EQUAL(0, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	inputs = IdleDesktop();
+	inputs.onBattery = true;
+	CHECK_EQUAL(policy.batteryTier, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	// Unknown charge is not a low battery
+	inputs.batteryPercent = -1;
+	CHECK_EQUAL(policy.batteryTier, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	inputs.batteryPercent = policy.lowBatteryPercent;
+	CHECK_EQUAL(policy.batterySaverTier, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	inputs = IdleDesktop();
+	inputs.batterySaver = true;
+	CHECK_EQUAL(policy.batterySaverTier, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	inputs = IdleDesktop();
+	inputs.userBusy = true;
+	CHECK_EQUAL(policy.userBusyTier, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	inputs = IdleDesktop();
+	inputs.occlusionFraction = policy.partialOcclusionThreshold - 0.01;
+	CHECK_EQUAL(0, RaylibDesktopEvaluateQualityTier(policy, inputs));
+	inputs.occlusionFraction = policy.partialOcclusionThreshold;
+	CHECK_EQUAL(policy.partialOcclusionTier, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	inputs = IdleDesktop();
+	inputs.inputIdleSeconds = policy.idleSeconds;
+	CHECK_EQUAL(policy.idleTier, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	// The lowest quality triggered tier wins
+	inputs = IdleDesktop();
+	inputs.onBattery = true;
+	inputs.userBusy = true;
+	inputs.occlusionFraction = 1.0;
+	CHECK_EQUAL(policy.userBusyTier, RaylibDesktopEvaluateQualityTier(policy, inputs));
+}
+
+static void TestDisabledRules()
+{
+	RaylibDesktopQualityPolicy policy = RaylibDesktopDefaultQualityPolicy();
+	policy.batteryTier = -1;
+	policy.userBusyTier = -1;
+
+	RaylibDesktopPolicyInputs inputs = IdleDesktop();
+	inputs.onBattery = true;
+	inputs.userBusy = true;
+	CHECK_EQUAL(0, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	// Other rules still apply
+	inputs.batterySaver = true;
+	CHECK_EQUAL(policy.batterySaverTier, RaylibDesktopEvaluateQualityTier(policy, inputs));
+}
+
+static void TestClamping()
+{
+	RaylibDesktopQualityPolicy policy = RaylibDesktopDefaultQualityPolicy();
+	policy.userBusyTier = 7;
+
+	RaylibDesktopPolicyInputs inputs = IdleDesktop();
+	inputs.userBusy = true;
+	CHECK_EQUAL(policy.tierCount - 1, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	// tierCount past the tiers array is limited to the array
+	policy.tierCount = 100;
+	policy.userBusyTier = 50;
+	CHECK_EQUAL(RAYLIB_DESKTOP_MAX_QUALITY_TIERS - 1, RaylibDesktopEvaluateQualityTier(policy, inputs));
+
+	// A policy without tiers falls back to full quality instead of a zeroed, paused tier
+	RaylibDesktopQualityPolicy emptyPolicy = {};
+	emptyPolicy.userBusyTier = 2;
+	CHECK_EQUAL(0, RaylibDesktopEvaluateQualityTier(emptyPolicy, inputs));
+
+	RaylibDesktopPolicyState state = {-1, -1, 0.0};
+	RaylibDesktopUpdateQualityTier(emptyPolicy, state, inputs, 0.0);
+	const RaylibDesktopQualityTier &tier = RaylibDesktopGetQualityTier(emptyPolicy, state);
+	CHECK(tier.targetFps > 0);
+	CHECK(tier.resolutionScale > 0.0f);
+
+	emptyPolicy.tierCount = -3;
+	CHECK(RaylibDesktopGetQualityTier(emptyPolicy, state).targetFps > 0);
+}
+
+static void TestHysteresis()
+{
+	RaylibDesktopQualityPolicy policy = RaylibDesktopDefaultQualityPolicy();
+	RaylibDesktopPolicyState state = {-1, -1, 0.0};
+	RaylibDesktopPolicyInputs inputs = IdleDesktop();
+
+	// Before the first update the first tier is used
+	CHECK_EQUAL(policy.tiers[0].targetFps, RaylibDesktopGetQualityTier(policy, state).targetFps);
+
+	// The first update switches immediately
+	CHECK(RaylibDesktopUpdateQualityTier(policy, state, inputs, 0.0));
+	CHECK_EQUAL(0, state.currentTier);
+	CHECK(!RaylibDesktopUpdateQualityTier(policy, state, inputs, 1.0));
+
+	// Downgrades are immediate
+	inputs.userBusy = true;
+	CHECK(RaylibDesktopUpdateQualityTier(policy, state, inputs, 2.0));
+	CHECK_EQUAL(policy.userBusyTier, state.currentTier);
+
+	// Upgrades wait for upgradeDelaySeconds
+	inputs.userBusy = false;
+	inputs.onBattery = true;
+	CHECK(!RaylibDesktopUpdateQualityTier(policy, state, inputs, 10.0));
+	CHECK_EQUAL(policy.userBusyTier, state.currentTier);
+	CHECK(!RaylibDesktopUpdateQualityTier(policy, state, inputs, 10.0 + policy.upgradeDelaySeconds - 0.5));
+	CHECK(RaylibDesktopUpdateQualityTier(policy, state, inputs, 10.0 + policy.upgradeDelaySeconds));
+	CHECK_EQUAL(policy.batteryTier, state.currentTier);
+	CHECK_EQUAL(-1, state.pendingTier);
+
+	// Requesting a different tier restarts the pending timer
+	inputs.onBattery = false;
+	inputs.userBusy = true;
+	RaylibDesktopUpdateQualityTier(policy, state, inputs, 20.0);
+	CHECK_EQUAL(policy.userBusyTier, state.currentTier);
+
+	inputs.userBusy = false;
+	inputs.onBattery = true;
+	CHECK(!RaylibDesktopUpdateQualityTier(policy, state, inputs, 21.0));
+	CHECK_EQUAL(policy.batteryTier, state.pendingTier);
+
+	inputs.onBattery = false;
+	CHECK(!RaylibDesktopUpdateQualityTier(policy, state, inputs, 22.0));
+	CHECK_EQUAL(0, state.pendingTier);
+	CHECK(!RaylibDesktopUpdateQualityTier(policy, state, inputs, 21.0 + policy.upgradeDelaySeconds));
+	CHECK_EQUAL(policy.userBusyTier, state.currentTier);
+	CHECK(RaylibDesktopUpdateQualityTier(policy, state, inputs, 22.0 + policy.upgradeDelaySeconds));
+	CHECK_EQUAL(0, state.currentTier);
+
+	// Returning to the current tier cancels a pending upgrade
+	inputs.userBusy = true;
+	RaylibDesktopUpdateQualityTier(policy, state, inputs, 30.0);
+	inputs.userBusy = false;
+	RaylibDesktopUpdateQualityTier(policy, state, inputs, 31.0);
+	CHECK_EQUAL(0, state.pendingTier);
+	inputs.userBusy = true;
+	CHECK(!RaylibDesktopUpdateQualityTier(policy, state, inputs, 32.0));
+	CHECK_EQUAL(-1, state.pendingTier);
+}
+
+int main()
+{
+	TestRules();
+	TestDisabledRules();
+	TestClamping();
+	TestHysteresis();
+	return TestResult("PolicyTest");
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdio.h>
+
+// Minimal checks shared by the tests, a failed check is printed and the test keeps going.
+// Every test returns TestResult() from main, so make test stops at the first failing binary.
+
+static int g_testFailures = 0;
+
+#define CHECK(condition)                                                                                               \
+	do {                                                                                                               \
+		if (!(condition)) {                                                                                            \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);                             \
+			g_testFailures++;                                                                                          \
+		}                                                                                                              \
+	} while (0)
+
+#define CHECK_EQUAL(expected, actual)                                                                                  \
+	do {                                                                                                               \
+		long long expectedValue = (long long)(expected);                                                               \
+		long long actualValue = (long long)(actual);                                                                   \
+		if (expectedValue != actualValue) {                                                                            \
+			fprintf(                                                                                                   \
+				stderr,                                                                                                \
+				"%s:%d: %s is %lld, expected %lld\n",                                                                  \
+				__FILE__,                                                                                              \
+				__LINE__,                                                                                              \
+				#actual,                                                                                               \
+				actualValue,                                                                                           \
+				expectedValue                                                                                          \
+			);                                                                                                         \
+			g_testFailures++;                                                                                          \
+		}                                                                                                              \
+	} while (0)
+
+// Prints the summary and returns the exit code of the test
+static int TestResult(const char *testName)
+{
+	if (g_testFailures > 0) {
+		fprintf(stderr, "%s: %d check(s) failed\n", testName, g_testFailures);
+		return 1;
+	}
+	printf("%s: passed\n", testName);
+	return 0;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cmath>
+#include <stdio.h>
+#include <vector>
+
+#include "RaylibDesktopAudioFft.h"
+
+// Writes seconds of 16 bit PCM mono, a tone sweeping across the spectrum, for the WAV audio source
+static bool WriteWave(const char *fileName, int sampleRate, double seconds)
+{
+	FILE *file = fopen(fileName, "wb");
+	if (!file)
+		return false;
+
+	const int sampleCount = static_cast<int>(sampleRate * seconds);
+	std::vector<short> samples(sampleCount);
+	double phase = 0.0;
+	for (int i = 0; i < sampleCount; i++) {
+		double frequency = 50.0 * std::pow(300.0, static_cast<double>(i) / sampleCount);
+		phase += 2.0 * AUDIO_PI * frequency / sampleRate;
+		samples[i] = static_cast<short>(std::sin(phase) * 16000.0);
+	}
+
+	auto write32 = [file](unsigned int value) {
+		unsigned char bytes[4] = {(unsigned char)value, (unsigned char)(value >> 8), (unsigned char)(value >> 16),
+								  (unsigned char)(value >> 24)};
+		fwrite(bytes, 1, 4, file);
+	};
+	auto write16 = [file](unsigned int value) {
+		unsigned char bytes[2] = {(unsigned char)value, (unsigned char)(value >> 8)};
+		fwrite(bytes, 1, 2, file);
+	};
+
+	unsigned int dataBytes = sampleCount * 2;
+	fwrite("RIFF", 1, 4, file);
+	write32(36 + dataBytes);
+	fwrite("WAVEfmt ", 1, 8, file);
+	write32(16);
+	write16(1); // PCM
+	write16(1); // Mono
+	write32(sampleRate);
+	write32(sampleRate * 2);
+	write16(2);
+	write16(16);
+	fwrite("data", 1, 4, file);
+	write32(dataBytes);
+	for (short sample : samples) {
+		write16(static_cast<unsigned short>(sample));
+	}
+	fclose(file);
+	return true;
+}